@@ -0,0 +1,51 @@
+//
+//  MappedFile.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+MappedFile::MappedFile(const std::string& path) : begin(nullptr), length(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), path);
+    
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), path);
+    }
+    
+    length = (size_t) info.st_size;
+    
+    // Пустой файл отобразить нельзя, но и читать из него нечего
+    if (length) {
+        void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        begin = (const char*) address;
+    }
+    
+    // Отображение остается действительным и после закрытия файла
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (begin)
+        munmap((void*) begin, length);
+}
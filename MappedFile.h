@@ -0,0 +1,53 @@
+//
+//  MappedFile.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef MappedFile_h
+#define MappedFile_h
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Файл, отображенный в память только для чтения.
+ * Страницы подгружаются системой по мере обращения к ним.
+ */
+class MappedFile {
+public:
+    
+    /**
+     * Отображает файл в память.
+     * @param path Путь к файлу.
+     * @throws std::system_error Если файл не удалось открыть или отобразить.
+     */
+    explicit MappedFile(const std::string& path);
+    
+    ~MappedFile();
+    
+    /**
+     * Начало отображенной памяти.
+     */
+    const char* data() const {
+        return begin;
+    }
+    
+    /**
+     * Размер файла в байтах.
+     */
+    size_t size() const {
+        return length;
+    }
+
+private:
+    const char* begin;
+    size_t length;
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+#endif /* MappedFile_h */
@@ -0,0 +1,134 @@
+//
+//  MappedTritSet.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "MappedTritSet.h"
+#include "TritWord.h"
+
+/**
+ * Применяет пословную операцию к двум массивам слов.
+ * @return Новый набор тритов.
+ */
+template <typename Op>
+static TritSet zipWords(const uint* left, size_t leftCount,
+                        const uint* right, size_t rightCount, Op op) {
+    std::vector<uint> result(leftCount > rightCount ? leftCount : rightCount);
+    tritWordsZip(left, leftCount, right, rightCount, result.data(), op);
+    return TritSet::fromWords(std::move(result));
+}
+
+MappedTritSet::MappedTritSet(const std::string& path)
+    : file(std::make_shared<MappedFile>(path)) {
+    
+    if (file->size() < sizeof(TritFileHeader))
+        throw std::runtime_error(path + ": not a trit set file");
+    
+    TritFileHeader header = tritFileHeaderDecode((const uint8_t*) file->data());
+    
+    if (!tritFileHeaderValid(header, file->size() - sizeof(TritFileHeader)))
+        throw std::runtime_error(path + ": corrupted trit set file");
+    
+    if (header.byteOrder != tritNativeByteOrder())
+        throw std::runtime_error(path + ": trit set file has foreign byte order");
+    
+    data = (const uint*) (file->data() + sizeof(TritFileHeader));
+    tritsCount = header.tritsCount;
+    checksum = header.checksum;
+}
+
+MappedTritSet::MappedTritSet(const std::shared_ptr<const MappedFile>& file, const uint* data,
+                             size_t tritsCount, uint64_t checksum)
+    : file(file), data(data), tritsCount(tritsCount), checksum(checksum) {}
+
+void MappedTritSet::write(const TritSet& set, const std::string& path) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream)
+        throw std::system_error(errno, std::generic_category(), path);
+    
+    set.serialize(stream);
+    
+    if (!stream.flush())
+        throw std::system_error(errno, std::generic_category(), path);
+}
+
+size_t MappedTritSet::size() const {
+    return tritsCount;
+}
+
+Trit MappedTritSet::getTrit(size_t pos) const {
+    if (pos >= tritsCount)
+        return Unknown;
+    
+    uint data = this->data[pos / TRITS_PER_WORD] >> (pos % TRITS_PER_WORD * 2);
+    
+    if (data & 0b01)
+        return False;
+    else if (data & 0b10)
+        return True;
+    
+    return Unknown;
+}
+
+size_t MappedTritSet::cardinality(Trit trit) const {
+    return tritWordsCardinality(data, tritsCount, trit);
+}
+
+std::unordered_map<Trit, size_t, std::hash<size_t>> MappedTritSet::cardinality() const {
+    std::unordered_map<Trit, size_t, std::hash<size_t>> map;
+    map.emplace(False, cardinality(False));
+    map.emplace(Unknown, cardinality(Unknown));
+    map.emplace(True, cardinality(True));
+    return map;
+}
+
+bool MappedTritSet::verify() const {
+    return tritChecksum(data, wordsCount()) == checksum;
+}
+
+TritSet MappedTritSet::toTritSet() const {
+    return TritSet::fromWords(data, wordsCount());
+}
+
+const uint* MappedTritSet::words() const {
+    return data;
+}
+
+size_t MappedTritSet::wordsCount() const {
+    return tritWordsCount(tritsCount);
+}
+
+TritSet MappedTritSet::operator~() const {
+    std::vector<uint> result(wordsCount());
+    
+    for (size_t i = 0; i < result.size(); i++)
+        result[i] = tritWordNot(data[i]);
+    
+    return TritSet::fromWords(std::move(result));
+}
+
+TritSet MappedTritSet::operator&(const MappedTritSet& set) const {
+    return zipWords(data, wordsCount(), set.data, set.wordsCount(), tritWordAnd);
+}
+
+TritSet MappedTritSet::operator&(const TritSet& set) const {
+    return zipWords(data, wordsCount(), set.words().data(),
+                    tritWordsCount(set.size()), tritWordAnd);
+}
+
+TritSet MappedTritSet::operator|(const MappedTritSet& set) const {
+    return zipWords(data, wordsCount(), set.data, set.wordsCount(), tritWordOr);
+}
+
+TritSet MappedTritSet::operator|(const TritSet& set) const {
+    return zipWords(data, wordsCount(), set.words().data(),
+                    tritWordsCount(set.size()), tritWordOr);
+}
@@ -0,0 +1,127 @@
+//
+//  MappedTritSet.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef MappedTritSet_h
+#define MappedTritSet_h
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "MappedFile.h"
+#include "TritFormat.h"
+#include "TritSet.h"
+
+/**
+ * Набор тритов только для чтения, отображенный из файла в память.
+ * Открытие не читает данные: триты подгружаются по мере обращения.
+ * Формат файла описан в TritFormat.h.
+ */
+class MappedTritSet {
+public:
+    
+    /**
+     * Отображает набор тритов из файла.
+     * Проверяется только заголовок, контрольная сумма - в verify().
+     * @param path Путь к файлу.
+     * @throws std::system_error Если файл не удалось открыть.
+     * @throws std::runtime_error Если файл поврежден или записан
+     * с другим размером слова или порядком байт.
+     */
+    explicit MappedTritSet(const std::string& path);
+    
+    /**
+     * Записывает набор тритов в файл.
+     * @param set Набор тритов.
+     * @param path Путь к файлу.
+     * @throws std::system_error Если файл не удалось записать.
+     */
+    static void write(const TritSet& set, const std::string& path);
+    
+    /**
+     * Размер набора тритов.
+     * @return Индекс последнего не Unknown трита + 1.
+     */
+    size_t size() const;
+    
+    /**
+     * Получает значение трита для данной позиции.
+     * @param pos Позиция для получения трита.
+     * @return Значение трита на данной позиции.
+     */
+    Trit getTrit(size_t pos) const;
+    
+    /**
+     * @see TritSet::cardinality(Trit)
+     */
+    size_t cardinality(Trit trit) const;
+    
+    /**
+     * @see TritSet::cardinality()
+     */
+    std::unordered_map<Trit, size_t, std::hash<size_t>> cardinality() const;
+    
+    /**
+     * Сверяет контрольную сумму данных с заголовком.
+     * Читает файл целиком.
+     * @return Совпадает ли контрольная сумма.
+     */
+    bool verify() const;
+    
+    /**
+     * Копирует набор тритов в память.
+     */
+    TritSet toTritSet() const;
+    
+    /**
+     * Слова данных в формате хранилища TritSet.
+     */
+    const uint* words() const;
+    
+    /**
+     * Кол-во слов данных.
+     */
+    size_t wordsCount() const;
+    
+    /**
+     * Логическое NOT.
+     */
+    TritSet operator~() const;
+    
+    /**
+     * Логическое AND.
+     */
+    TritSet operator&(const MappedTritSet& set) const;
+    TritSet operator&(const TritSet& set) const;
+    
+    /**
+     * Логическое OR.
+     */
+    TritSet operator|(const MappedTritSet& set) const;
+    TritSet operator|(const TritSet& set) const;
+
+private:
+    std::shared_ptr<const MappedFile> file;
+    const uint* data;
+    size_t tritsCount;
+    uint64_t checksum;
+    
+    /**
+     * Набор тритов внутри уже отображенного файла.
+     * @param file Отображенный файл.
+     * @param data Слова набора тритов внутри файла.
+     * @param tritsCount Размер набора тритов.
+     * @param checksum Контрольная сумма слов.
+     */
+    MappedTritSet(const std::shared_ptr<const MappedFile>& file, const uint* data,
+                  size_t tritsCount, uint64_t checksum);
+    
+    friend class TritDataset;
+};
+
+#endif /* MappedTritSet_h */
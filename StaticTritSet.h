@@ -0,0 +1,183 @@
+//
+//  StaticTritSet.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef StaticTritSet_h
+#define StaticTritSet_h
+
+#include <cstddef>
+
+#include "TritSet.h"
+#include "TritWord.h"
+
+/**
+ * Набор из N тритов фиксированного размера, как std::bitset<N>.
+ *
+ * Хранилище того же формата, что и у TritSet, лежит внутри объекта,
+ * а размер известен при компиляции, поэтому все операции constexpr
+ * и не выделяют память. Циклы по словам имеют постоянную длину
+ * и разворачиваются компилятором.
+ */
+template <size_t N>
+class StaticTritSet {
+public:
+    
+    /** Кол-во слов хранилища. */
+    static constexpr size_t WORDS = N ? tritWordsCount(N) : 1;
+    
+    /**
+     * Набор из N тритов Unknown.
+     */
+    constexpr StaticTritSet() : storage() {}
+    
+    /**
+     * Набор из N тритов данного значения.
+     */
+    explicit constexpr StaticTritSet(Trit fill) : storage() {
+        for (size_t i = 0; i < WORDS; i++)
+            storage[i] = tritWordFill(fill);
+        maskTail();
+    }
+    
+    /**
+     * Копирует первые N тритов динамического набора.
+     */
+    explicit StaticTritSet(const TritSet& set) : storage() {
+        const std::vector<uint>& words = set.words();
+        for (size_t i = 0; i < WORDS && i < words.size(); i++)
+            storage[i] = words[i];
+        maskTail();
+    }
+    
+    /**
+     * Размер набора, всегда N.
+     */
+    constexpr size_t size() const {
+        return N;
+    }
+    
+    /**
+     * Получает значение трита.
+     * @param pos Позиция трита, за пределами набора - Unknown.
+     */
+    constexpr Trit getTrit(size_t pos) const {
+        if (pos >= N)
+            return Unknown;
+        
+        return tritFromCode((storage[pos / TRITS_PER_WORD] >> (pos % TRITS_PER_WORD * 2)) & 0b11);
+    }
+    
+    /**
+     * @see getTrit(size_t)
+     */
+    constexpr Trit operator[](size_t pos) const {
+        return getTrit(pos);
+    }
+    
+    /**
+     * Устанавливает трит.
+     * @param pos Позиция трита, запись за пределами набора игнорируется.
+     * @param value Значение.
+     * @return Измененный объект(самого себя)
+     */
+    constexpr StaticTritSet& setTrit(size_t pos, Trit value) {
+        if (pos >= N)
+            return *this;
+        
+        size_t shift = pos % TRITS_PER_WORD * 2;
+        uint& word = storage[pos / TRITS_PER_WORD];
+        word = (word & ~((uint) 0b11 << shift)) | ((tritWordFill(value) & 0b11) << shift);
+        return *this;
+    }
+    
+    /**
+     * Кол-во тритов данного значения среди N тритов набора.
+     */
+    constexpr size_t cardinality(Trit trit) const {
+        if (trit == Unknown)
+            return N - cardinality(False) - cardinality(True);
+        
+        size_t count = 0;
+        for (size_t i = 0; i < WORDS; i++)
+            count += popcount(tritWordMatch(storage[i], trit));
+        return count;
+    }
+    
+    constexpr StaticTritSet operator~() const {
+        StaticTritSet result;
+        for (size_t i = 0; i < WORDS; i++)
+            result.storage[i] = tritWordNot(storage[i]);
+        return result;
+    }
+    
+    constexpr StaticTritSet operator&(const StaticTritSet& set) const {
+        return StaticTritSet(*this) &= set;
+    }
+    
+    constexpr StaticTritSet operator|(const StaticTritSet& set) const {
+        return StaticTritSet(*this) |= set;
+    }
+    
+    constexpr StaticTritSet& operator&=(const StaticTritSet& set) {
+        for (size_t i = 0; i < WORDS; i++)
+            storage[i] = tritWordAnd(storage[i], set.storage[i]);
+        return *this;
+    }
+    
+    constexpr StaticTritSet& operator|=(const StaticTritSet& set) {
+        for (size_t i = 0; i < WORDS; i++)
+            storage[i] = tritWordOr(storage[i], set.storage[i]);
+        return *this;
+    }
+    
+    constexpr bool operator==(const StaticTritSet& set) const {
+        for (size_t i = 0; i < WORDS; i++)
+            if (storage[i] != set.storage[i])
+                return false;
+        return true;
+    }
+    
+    constexpr bool operator!=(const StaticTritSet& set) const {
+        return !(*this == set);
+    }
+    
+    /**
+     * Слова хранилища в формате TritSet.
+     */
+    constexpr const uint* words() const {
+        return storage;
+    }
+    
+    /**
+     * Копирует набор в динамический набор тритов.
+     */
+    TritSet toTritSet() const {
+        return TritSet::fromWords(storage, WORDS);
+    }
+
+private:
+    
+    // В C++14 у std::array нет constexpr изменяющего operator[], поэтому массив
+    uint storage[WORDS];
+    
+    /** Сбрасывает триты после N в последнем слове. */
+    constexpr void maskTail() {
+        storage[WORDS - 1] &= N ? tritWordLowMask(N - (WORDS - 1) * TRITS_PER_WORD) : 0;
+    }
+    
+    /** wordPopcount, вычислимый при компиляции. */
+    static constexpr size_t popcount(uint word) {
+        word = word - ((word >> 1) & 0x55555555);
+        word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+        return (((word + (word >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+    }
+};
+
+template <size_t N>
+constexpr size_t StaticTritSet<N>::WORDS;
+
+#endif /* StaticTritSet_h */
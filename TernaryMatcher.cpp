@@ -0,0 +1,171 @@
+//
+//  TernaryMatcher.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#include "TernaryMatcher.h"
+#include "TritWord.h"
+
+/**
+ * При TernaryAuto таблицы строятся, если групп не больше
+ * этой доли от кол-ва правил.
+ */
+#define TUPLES_RATIO 8
+
+/**
+ * Маска значимых битов: оба бита каждого известного трита.
+ */
+static uint careMask(uint word) {
+    uint known = tritWordKnown(word);
+    return known | (known << 1);
+}
+
+TernaryMatcher::TernaryMatcher(const std::vector<TritSet>& rules, TernaryIndex index)
+    : rulesCount(rules.size()), ruleWords(0) {
+    
+    if (rulesCount > UINT32_MAX)
+        throw std::invalid_argument("too many rules for ternary matcher");
+    
+    for (const TritSet& rule : rules)
+        ruleWords = std::max(ruleWords, tritWordsCount(rule.size()));
+    
+    values.resize(rulesCount * ruleWords);
+    cares.resize(rulesCount * ruleWords);
+    lengths.resize(rulesCount);
+    
+    for (size_t i = 0; i < rulesCount; i++) {
+        const std::vector<uint>& words = rules[i].words();
+        lengths[i] = tritWordsCount(rules[i].size());
+        
+        for (size_t j = 0; j < lengths[i]; j++) {
+            values[i * ruleWords + j] = words[j];
+            cares[i * ruleWords + j] = careMask(words[j]);
+        }
+    }
+    
+    if (index != TernaryScan)
+        buildTuples();
+    
+    if (index == TernaryAuto && tuples.size() * TUPLES_RATIO > rulesCount)
+        tuples.clear();
+}
+
+void TernaryMatcher::buildTuples() {
+    // Группы по маске значимых позиций в порядке первого правила
+    std::map<std::vector<uint>, size_t> groups;
+    
+    for (size_t i = 0; i < rulesCount; i++) {
+        std::vector<uint> care(cares.begin() + i * ruleWords, cares.begin() + (i + 1) * ruleWords);
+        
+        auto group = groups.find(care);
+        if (group == groups.end()) {
+            group = groups.emplace(care, tuples.size()).first;
+            tuples.push_back({care, i, {}});
+        }
+        
+        Tuple& tuple = tuples[group->second];
+        tuple.rules[tupleHash(tuple, values.data() + i * ruleWords)].push_back((uint32_t) i);
+    }
+}
+
+size_t TernaryMatcher::size() const {
+    return rulesCount;
+}
+
+size_t TernaryMatcher::tuplesCount() const {
+    return tuples.size();
+}
+
+size_t TernaryMatcher::match(const TritSet& key) const {
+    std::vector<uint> words = keyWords(key);
+    
+    if (tuples.empty()) {
+        for (size_t i = 0; i < rulesCount; i++)
+            if (matches(i, words.data()))
+                return i;
+        return TritSet::npos;
+    }
+    
+    size_t best = TritSet::npos;
+    
+    for (const Tuple& tuple : tuples) {
+        // Группы упорядочены по первому правилу: дальше лучше не найти
+        if (tuple.first >= best)
+            break;
+        
+        auto candidates = tuple.rules.find(tupleHash(tuple, words.data()));
+        if (candidates == tuple.rules.end())
+            continue;
+        
+        // Номера в списке возрастают, хеш мог совпасть случайно
+        for (uint32_t rule : candidates->second) {
+            if (rule >= best)
+                break;
+            if (matches(rule, words.data())) {
+                best = rule;
+                break;
+            }
+        }
+    }
+    
+    return best;
+}
+
+std::vector<size_t> TernaryMatcher::matchAll(const TritSet& key) const {
+    std::vector<uint> words = keyWords(key);
+    std::vector<size_t> result;
+    
+    if (tuples.empty()) {
+        for (size_t i = 0; i < rulesCount; i++)
+            if (matches(i, words.data()))
+                result.push_back(i);
+        return result;
+    }
+    
+    for (const Tuple& tuple : tuples) {
+        auto candidates = tuple.rules.find(tupleHash(tuple, words.data()));
+        if (candidates == tuple.rules.end())
+            continue;
+        
+        for (uint32_t rule : candidates->second)
+            if (matches(rule, words.data()))
+                result.push_back(rule);
+    }
+    
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool TernaryMatcher::matches(size_t rule, const uint* key) const {
+    const uint* value = values.data() + rule * ruleWords;
+    const uint* care = cares.data() + rule * ruleWords;
+    
+    for (size_t i = 0; i < lengths[rule]; i++)
+        if ((key[i] ^ value[i]) & care[i])
+            return false;
+    
+    return true;
+}
+
+std::vector<uint> TernaryMatcher::keyWords(const TritSet& key) const {
+    const std::vector<uint>& words = key.words();
+    std::vector<uint> result(ruleWords);
+    
+    std::copy(words.begin(), words.begin() + std::min(words.size(), ruleWords), result.begin());
+    return result;
+}
+
+uint64_t TernaryMatcher::tupleHash(const Tuple& tuple, const uint* key) const {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < ruleWords; i++)
+        hash = (hash ^ (key[i] & tuple.care[i])) * 0x9E3779B97F4A7C15ULL;
+    
+    return hash ^ (hash >> 32);
+}
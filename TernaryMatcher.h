@@ -0,0 +1,119 @@
+//
+//  TernaryMatcher.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TernaryMatcher_h
+#define TernaryMatcher_h
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "TritSet.h"
+
+/**
+ * Способ поиска правил.
+ */
+enum TernaryIndex {
+    TernaryScan,      // Перебор всех правил
+    TernaryTupleSpace, // Хеш-таблица на каждый набор значимых позиций
+    TernaryAuto       // Таблицы, если наборов значимых позиций мало
+};
+
+/**
+ * Эмуляция троичной ассоциативной памяти (TCAM).
+ *
+ * Правило - набор тритов, где Unknown означает "любое значение".
+ * Ключ подходит под правило, если на каждой известной позиции правила
+ * у ключа тот же трит. Правило компилируется в слова значений и маски
+ * значимых битов, и сравнение идет по 16 позиций за операцию:
+ * (key ^ value) & care == 0.
+ *
+ * Для большого кол-ва правил строится индекс пространства кортежей:
+ * правила группируются по маске значимых позиций, и в каждой группе
+ * ищется хеш ключа, наложенного на маску. Поиск стоит по одной
+ * хеш-таблице на группу вместо перебора всех правил.
+ */
+class TernaryMatcher {
+public:
+    
+    /**
+     * Компилирует правила.
+     * @param rules Правила, номер правила - его индекс в массиве,
+     * меньший номер - больший приоритет.
+     * @param index Способ поиска.
+     * @throws std::invalid_argument Если правил больше UINT32_MAX.
+     */
+    explicit TernaryMatcher(const std::vector<TritSet>& rules, TernaryIndex index = TernaryAuto);
+    
+    /**
+     * Кол-во правил.
+     */
+    size_t size() const;
+    
+    /**
+     * Кол-во групп индекса или 0, если правила перебираются.
+     */
+    size_t tuplesCount() const;
+    
+    /**
+     * Первое подходящее под ключ правило.
+     * @param key Ключ, триты после его конца считаются Unknown
+     * и не подходят под известные триты правил.
+     * @return Номер правила или TritSet::npos, если подходящих нет.
+     */
+    size_t match(const TritSet& key) const;
+    
+    /**
+     * Все подходящие под ключ правила в порядке возрастания номеров.
+     * @see match(const TritSet&)
+     */
+    std::vector<size_t> matchAll(const TritSet& key) const;
+
+private:
+    
+    /**
+     * Группа правил с одинаковой маской значимых позиций.
+     */
+    struct Tuple {
+        std::vector<uint> care;
+        size_t first; // Наименьший номер правила группы
+        std::unordered_map<uint64_t, std::vector<uint32_t>> rules; // Номера правил по хешу
+    };
+    
+    size_t rulesCount;
+    size_t ruleWords; // Слов на правило
+    
+    std::vector<uint> values;
+    std::vector<uint> cares;
+    std::vector<size_t> lengths; // Значимых слов правила
+    
+    // Отсортированы по наименьшему номеру правила
+    std::vector<Tuple> tuples;
+    
+    /**
+     * Подходит ли ключ под правило.
+     * @param rule Номер правила.
+     * @param key Слова ключа, не меньше ruleWords.
+     */
+    bool matches(size_t rule, const uint* key) const;
+    
+    /**
+     * Слова ключа, дополненные нулями до ruleWords.
+     */
+    std::vector<uint> keyWords(const TritSet& key) const;
+    
+    /**
+     * Хеш ключа, наложенного на маску группы.
+     */
+    uint64_t tupleHash(const Tuple& tuple, const uint* key) const;
+    
+    void buildTuples();
+};
+
+#endif /* TernaryMatcher_h */
@@ -0,0 +1,47 @@
+//
+//  TritApply.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstdint>
+
+#include "TritApply.h"
+
+TritSet applyBinary(const TritSet& left, const TritSet& right, const Trit (&table)[3][3]) {
+    
+    // Индекс - два трита левого операнда (младшие 4 бита) и два трита правого,
+    // значение - два трита результата. Код 11 в хранилище не встречается.
+    uint8_t nibbles[256];
+    for (uint index = 0; index < 256; index++) {
+        uint result = 0;
+        
+        for (uint i = 0; i < 2; i++) {
+            uint leftCode = (index >> (i * 2)) & 0b11;
+            uint rightCode = (index >> (4 + i * 2)) & 0b11;
+            if (leftCode != 0b11 && rightCode != 0b11)
+                result |= tritCode(table[tritFromCode(leftCode)][tritFromCode(rightCode)]) << (i * 2);
+        }
+        
+        nibbles[index] = (uint8_t) result;
+    }
+    
+    size_t tritsCount = left.size() > right.size() ? left.size() : right.size();
+    std::vector<uint> result(tritWordsCount(tritsCount));
+    
+    tritWordsZip(left.words().data(), tritWordsCount(left.size()),
+                 right.words().data(), tritWordsCount(right.size()),
+                 result.data(), [&nibbles](uint leftWord, uint rightWord) {
+        uint word = 0;
+        for (size_t shift = 0; shift < sizeof(uint) * 8; shift += 4)
+            word |= (uint) nibbles[((leftWord >> shift) & 0xF) | (((rightWord >> shift) & 0xF) << 4)] << shift;
+        return word;
+    });
+    
+    if (tritsCount % TRITS_PER_WORD)
+        result.back() &= tritWordLowMask(tritsCount % TRITS_PER_WORD);
+    
+    return TritSet::fromWords(std::move(result));
+}
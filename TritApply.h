@@ -0,0 +1,123 @@
+//
+//  TritApply.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritApply_h
+#define TritApply_h
+
+#include <cstddef>
+#include <vector>
+
+#include "TritSet.h"
+#include "TritWord.h"
+
+/**
+ * Произвольные двуместные тритовые функции над наборами тритов.
+ *
+ * Функция задается таблицей истинности 3x3. Для таблицы, известной
+ * при компиляции, пословная формула строится из индикаторов значений:
+ * для каждого значения результата объединяются маски (left == i) & (right == j)
+ * по всем клеткам таблицы с этим значением. Клетки одной строки сливаются
+ * в одну маску правого операнда, и после свертки констант остается
+ * несколько битовых операций на слово, как у встроенных AND и OR.
+ */
+
+/**
+ * Таблица истинности, заданная параметрами шаблона.
+ * Имя параметра - значения левого и правого операндов, например
+ * UT - результат для Unknown и True.
+ */
+template <Trit FF, Trit FU, Trit FT, Trit UF, Trit UU, Trit UT, Trit TF, Trit TU, Trit TT>
+struct TritTruthTable {
+    
+    static constexpr Trit value(Trit left, Trit right) {
+        return left == False ? (right == False ? FF : (right == Unknown ? FU : FT))
+            : (left == Unknown ? (right == False ? UF : (right == Unknown ? UU : UT))
+               : (right == False ? TF : (right == Unknown ? TU : TT)));
+    }
+};
+
+/**
+ * Пословное применение функции с таблицей истинности Table.
+ * Table - тип со статической constexpr функцией value(Trit, Trit).
+ */
+template <typename Table>
+struct TritWordBinary {
+    
+    /**
+     * Маска младших битов тритов слова со значением trit.
+     */
+    static constexpr uint plane(uint word, Trit trit) {
+        return tritWordMatch(word, trit);
+    }
+    
+    /**
+     * Маска тритов правого операнда, для которых значение функции
+     * в строке left равно result.
+     */
+    static constexpr uint rowMask(uint right, Trit left, Trit result) {
+        bool isFalse = Table::value(left, False) == result;
+        bool isUnknown = Table::value(left, Unknown) == result;
+        bool isTrue = Table::value(left, True) == result;
+        
+        // Объединение двух значений - дополнение третьего
+        return isFalse && isUnknown && isTrue ? FALSE_PLANE
+            : (isFalse && isUnknown ? ~plane(right, True) & FALSE_PLANE
+               : (isFalse && isTrue ? ~plane(right, Unknown) & FALSE_PLANE
+                  : (isUnknown && isTrue ? ~plane(right, False) & FALSE_PLANE
+                     : (isFalse ? plane(right, False)
+                        : (isUnknown ? plane(right, Unknown)
+                           : (isTrue ? plane(right, True) : 0))))));
+    }
+    
+    /**
+     * Маска младших битов тритов, для которых значение функции равно result.
+     */
+    static constexpr uint resultMask(uint left, uint right, Trit result) {
+        return (plane(left, False) & rowMask(right, False, result))
+            | (plane(left, Unknown) & rowMask(right, Unknown, result))
+            | (plane(left, True) & rowMask(right, True, result));
+    }
+    
+    static constexpr uint apply(uint left, uint right) {
+        return resultMask(left, right, False) | (resultMask(left, right, True) << 1);
+    }
+};
+
+/**
+ * Применяет функцию с таблицей истинности Table ко всем тритам наборов.
+ * Более короткий набор дополняется тритами Unknown, триты после
+ * большего из размеров остаются Unknown.
+ *
+ * Пример: applyBinary<TritTruthTable<False, False, False, False, Unknown,
+ * Unknown, False, Unknown, True>>(a, b) == (a & b).
+ */
+template <typename Table>
+TritSet applyBinary(const TritSet& left, const TritSet& right) {
+    size_t tritsCount = left.size() > right.size() ? left.size() : right.size();
+    std::vector<uint> result(tritWordsCount(tritsCount));
+    
+    tritWordsZip(left.words().data(), tritWordsCount(left.size()),
+                 right.words().data(), tritWordsCount(right.size()),
+                 result.data(), TritWordBinary<Table>::apply);
+    
+    if (tritsCount % TRITS_PER_WORD)
+        result.back() &= tritWordLowMask(tritsCount % TRITS_PER_WORD);
+    
+    return TritSet::fromWords(std::move(result));
+}
+
+/**
+ * Применяет функцию, таблица истинности которой известна только
+ * во время выполнения. Результат вычисляется по таблице на 256 значений:
+ * по два трита (4 бита) каждого операнда за одно обращение.
+ * @param table Таблица истинности, table[left][right].
+ * @see applyBinary(const TritSet&, const TritSet&)
+ */
+TritSet applyBinary(const TritSet& left, const TritSet& right, const Trit (&table)[3][3]);
+
+#endif /* TritApply_h */
@@ -0,0 +1,315 @@
+//
+//  TritCircuit.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "TritCircuit.h"
+#include "TritWord.h"
+
+/** Кол-во слов векторов, моделируемых за один проход по схеме. */
+#define BLOCK_WORDS 64
+
+size_t TritCircuit::addInput() {
+    signals.push_back({true, GateBuffer, fanins.size(), 0});
+    inputs.push_back(signals.size() - 1);
+    return signals.size() - 1;
+}
+
+size_t TritCircuit::addGate(TritGateType type, const std::vector<size_t>& inputs) {
+    bool unary = type == GateBuffer || type == GateNot;
+    if (inputs.empty() || (unary && inputs.size() != 1))
+        throw std::invalid_argument("wrong number of trit gate inputs");
+    
+    signals.push_back({false, type, fanins.size(), inputs.size()});
+    fanins.insert(fanins.end(), inputs.begin(), inputs.end());
+    return signals.size() - 1;
+}
+
+size_t TritCircuit::addOutput(size_t signal) {
+    outputs.push_back(signal);
+    return outputs.size() - 1;
+}
+
+size_t TritCircuit::signalsCount() const {
+    return signals.size();
+}
+
+size_t TritCircuit::inputsCount() const {
+    return inputs.size();
+}
+
+size_t TritCircuit::outputsCount() const {
+    return outputs.size();
+}
+
+size_t TritCircuit::depth() const {
+    std::vector<size_t> levels;
+    levelize(levels);
+    
+    size_t result = 0;
+    for (size_t output : outputs)
+        result = std::max(result, levels[output]);
+    
+    return result;
+}
+
+std::vector<size_t> TritCircuit::levelize(std::vector<size_t>& levels) const {
+    size_t count = signals.size();
+    
+    for (size_t signal : fanins)
+        if (signal >= count)
+            throw std::runtime_error("trit gate input refers to a missing signal");
+    for (size_t signal : outputs)
+        if (signal >= count)
+            throw std::runtime_error("trit circuit output refers to a missing signal");
+    
+    // Разветвления сигналов в виде смещений и списка элементов
+    std::vector<size_t> offsets(count + 1);
+    for (size_t signal : fanins)
+        offsets[signal + 1]++;
+    for (size_t i = 0; i < count; i++)
+        offsets[i + 1] += offsets[i];
+    
+    std::vector<size_t> fanouts(fanins.size());
+    std::vector<size_t> filled(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < count; i++)
+        for (size_t j = 0; j < signals[i].count; j++)
+            fanouts[filled[fanins[signals[i].first + j]]++] = i;
+    
+    // Топологическая сортировка: элемент готов, когда вычислены все его входы
+    std::vector<size_t> pending(count);
+    std::vector<size_t> ready;
+    levels.assign(count, 0);
+    
+    for (size_t i = 0; i < count; i++) {
+        pending[i] = signals[i].count;
+        if (!pending[i])
+            ready.push_back(i);
+    }
+    
+    size_t processed = 0;
+    while (!ready.empty()) {
+        size_t signal = ready.back();
+        ready.pop_back();
+        processed++;
+        
+        for (size_t i = offsets[signal]; i < offsets[signal + 1]; i++) {
+            size_t gate = fanouts[i];
+            levels[gate] = std::max(levels[gate], levels[signal] + 1);
+            if (!--pending[gate])
+                ready.push_back(gate);
+        }
+    }
+    
+    if (processed < count)
+        throw std::runtime_error("trit circuit has a combinational loop");
+    
+    std::vector<size_t> order;
+    for (size_t i = 0; i < count; i++)
+        if (!signals[i].input)
+            order.push_back(i);
+    
+    std::stable_sort(order.begin(), order.end(),
+                     [&levels](size_t left, size_t right) { return levels[left] < levels[right]; });
+    return order;
+}
+
+TritCircuit::Program TritCircuit::compile() const {
+    std::vector<size_t> levels;
+    std::vector<size_t> order = levelize(levels);
+    
+    // Отбрасываем элементы, не влияющие на выходы
+    std::vector<bool> needed(signals.size()), output(signals.size());
+    for (size_t signal : outputs)
+        needed[signal] = output[signal] = true;
+    
+    for (auto gate = order.rbegin(); gate != order.rend(); ++gate)
+        if (needed[*gate])
+            for (size_t i = 0; i < signals[*gate].count; i++)
+                needed[fanins[signals[*gate].first + i]] = true;
+    
+    std::vector<size_t> uses(signals.size());
+    for (size_t gate : order)
+        if (needed[gate])
+            for (size_t i = 0; i < signals[gate].count; i++)
+                uses[fanins[signals[gate].first + i]]++;
+    
+    // Буферы назначаются по времени жизни сигналов и переиспользуются
+    Program program;
+    program.buffers = 0;
+    std::vector<size_t> buffer(signals.size()), released;
+    
+    auto allocate = [&program, &released]() {
+        if (released.empty())
+            return program.buffers++;
+        size_t result = released.back();
+        released.pop_back();
+        return result;
+    };
+    
+    for (size_t input : inputs) {
+        buffer[input] = allocate();
+        program.inputs.push_back(buffer[input]);
+    }
+    
+    for (size_t gate : order) {
+        if (!needed[gate])
+            continue;
+        
+        const Signal& signal = signals[gate];
+        
+        // Результат не совпадает с буферами входов: входы читаются по очереди
+        buffer[gate] = allocate();
+        program.instructions.push_back({signal.type, buffer[gate], program.operands.size(), signal.count});
+        
+        for (size_t i = 0; i < signal.count; i++) {
+            size_t operand = fanins[signal.first + i];
+            program.operands.push_back(buffer[operand]);
+            if (!--uses[operand] && !output[operand])
+                released.push_back(buffer[operand]);
+        }
+    }
+    
+    for (size_t signal : outputs)
+        program.outputs.push_back(buffer[signal]);
+    
+    return program;
+}
+
+/**
+ * Применяет пословную операцию ко всем входам элемента.
+ * @param result Буфер результата.
+ * @param buffers Буферы сигналов.
+ * @param operands Номера буферов входов.
+ * @param count Кол-во входов.
+ * @param words Кол-во слов.
+ * @param invert Инвертировать ли результат.
+ */
+template <typename Operation>
+static void evaluateGate(uint* result, const uint* buffers, const size_t* operands, size_t count,
+                         size_t words, bool invert, Operation operation) {
+    const uint* first = buffers + operands[0] * BLOCK_WORDS;
+    
+    if (count == 1) {
+        for (size_t w = 0; w < words; w++)
+            result[w] = first[w];
+    } else {
+        const uint* second = buffers + operands[1] * BLOCK_WORDS;
+        for (size_t w = 0; w < words; w++)
+            result[w] = operation(first[w], second[w]);
+    }
+    
+    for (size_t i = 2; i < count; i++) {
+        const uint* operand = buffers + operands[i] * BLOCK_WORDS;
+        for (size_t w = 0; w < words; w++)
+            result[w] = operation(result[w], operand[w]);
+    }
+    
+    if (invert)
+        for (size_t w = 0; w < words; w++)
+            result[w] = tritWordNot(result[w]);
+}
+
+void TritCircuit::simulateBlock(const Program& program, const std::vector<TritSet>& values,
+                                std::vector<std::vector<uint>>& results,
+                                size_t block, size_t wordsCount, uint* buffers) const {
+    size_t start = block * BLOCK_WORDS;
+    size_t words = std::min((size_t) BLOCK_WORDS, wordsCount - start);
+    
+    for (size_t i = 0; i < program.inputs.size(); i++) {
+        const std::vector<uint>& source = values[i].words();
+        uint* destination = buffers + program.inputs[i] * BLOCK_WORDS;
+        for (size_t w = 0; w < words; w++)
+            destination[w] = start + w < source.size() ? source[start + w] : 0;
+    }
+    
+    auto andWords = [](uint left, uint right) { return tritWordAnd(left, right); };
+    auto orWords = [](uint left, uint right) { return tritWordOr(left, right); };
+    auto xorWords = [](uint left, uint right) { return tritWordXor(left, right); };
+    
+    for (const Instruction& instruction : program.instructions) {
+        uint* result = buffers + instruction.result * BLOCK_WORDS;
+        const size_t* operands = program.operands.data() + instruction.first;
+        size_t count = instruction.count;
+        
+        switch (instruction.type) {
+            case GateBuffer:
+            case GateNot:
+                evaluateGate(result, buffers, operands, count, words, instruction.type == GateNot,
+                             andWords);
+                break;
+            case GateAnd:
+            case GateNand:
+                evaluateGate(result, buffers, operands, count, words, instruction.type == GateNand,
+                             andWords);
+                break;
+            case GateOr:
+            case GateNor:
+                evaluateGate(result, buffers, operands, count, words, instruction.type == GateNor,
+                             orWords);
+                break;
+            case GateXor:
+            case GateXnor:
+                evaluateGate(result, buffers, operands, count, words, instruction.type == GateXnor,
+                             xorWords);
+                break;
+        }
+    }
+    
+    for (size_t i = 0; i < program.outputs.size(); i++) {
+        const uint* source = buffers + program.outputs[i] * BLOCK_WORDS;
+        std::copy(source, source + words, results[i].begin() + start);
+    }
+}
+
+std::vector<TritSet> TritCircuit::simulate(const std::vector<TritSet>& values, size_t threads) const {
+    if (values.size() != inputs.size())
+        throw std::invalid_argument("wrong number of trit circuit input values");
+    
+    Program program = compile();
+    
+    size_t vectors = 0;
+    for (const TritSet& value : values)
+        vectors = std::max(vectors, value.size());
+    
+    size_t wordsCount = tritWordsCount(vectors);
+    size_t blocks = (wordsCount + BLOCK_WORDS - 1) / BLOCK_WORDS;
+    std::vector<std::vector<uint>> results(outputs.size(), std::vector<uint>(wordsCount));
+    
+    if (!threads)
+        threads = std::thread::hardware_concurrency();
+    if (threads > blocks)
+        threads = blocks;
+    
+    if (threads <= 1) {
+        std::vector<uint> buffers(program.buffers * BLOCK_WORDS);
+        for (size_t i = 0; i < blocks; i++)
+            simulateBlock(program, values, results, i, wordsCount, buffers.data());
+    } else {
+        // Блоки векторов независимы и пишут в непересекающиеся слова выходов
+        std::vector<std::thread> workers;
+        
+        for (size_t t = 0; t < threads; t++)
+            workers.emplace_back([this, t, threads, blocks, wordsCount, &program, &values, &results]() {
+                std::vector<uint> buffers(program.buffers * BLOCK_WORDS);
+                for (size_t i = t; i < blocks; i += threads)
+                    simulateBlock(program, values, results, i, wordsCount, buffers.data());
+            });
+        
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+    
+    std::vector<TritSet> result;
+    for (std::vector<uint>& words : results)
+        result.push_back(TritSet::fromWords(std::move(words)));
+    
+    return result;
+}
@@ -0,0 +1,161 @@
+//
+//  TritCircuit.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritCircuit_h
+#define TritCircuit_h
+
+#include <cstddef>
+#include <vector>
+
+#include "TritSet.h"
+
+/**
+ * Тип логического элемента.
+ */
+enum TritGateType {
+    GateBuffer, // Один вход
+    GateNot,    // Один вход
+    GateAnd,
+    GateOr,
+    GateXor,
+    GateNand,
+    GateNor,
+    GateXnor
+};
+
+/**
+ * Моделирование комбинационной схемы в троичной логике:
+ * Unknown - неизвестное значение сигнала (X), которое распространяется
+ * по элементам по правилам операций TritSet.
+ *
+ * Значение сигнала - набор тритов, позиция которого - отдельный тестовый
+ * вектор, поэтому элемент вычисляется сразу для 16 векторов за операцию
+ * над словом хранилища.
+ *
+ * Перед моделированием схема упорядочивается по уровням, элементы,
+ * не влияющие на выходы, отбрасываются, а сигналам назначаются
+ * переиспользуемые буферы по времени жизни. Векторы обрабатываются
+ * блоками, в пределах которых живые сигналы остаются в кэше.
+ */
+class TritCircuit {
+public:
+    
+    /**
+     * Добавляет вход схемы.
+     * @return Номер сигнала входа.
+     */
+    size_t addInput();
+    
+    /**
+     * Добавляет элемент. Входы могут ссылаться на сигналы,
+     * которые будут добавлены позже.
+     * @param type Тип элемента.
+     * @param inputs Номера входных сигналов.
+     * @return Номер выходного сигнала элемента.
+     * @throws std::invalid_argument Если кол-во входов не подходит к типу.
+     */
+    size_t addGate(TritGateType type, const std::vector<size_t>& inputs);
+    
+    /**
+     * Добавляет выход схемы.
+     * @param signal Номер сигнала.
+     * @return Номер выхода.
+     */
+    size_t addOutput(size_t signal);
+    
+    /**
+     * Кол-во сигналов: входов и элементов.
+     */
+    size_t signalsCount() const;
+    
+    /**
+     * Кол-во входов.
+     */
+    size_t inputsCount() const;
+    
+    /**
+     * Кол-во выходов.
+     */
+    size_t outputsCount() const;
+    
+    /**
+     * Глубина схемы: наибольший уровень выхода, у входов уровень 0.
+     * @throws std::runtime_error Если в схеме есть цикл или ссылка
+     * на несуществующий сигнал.
+     */
+    size_t depth() const;
+    
+    /**
+     * Моделирует схему.
+     * @param inputs Значения входов в порядке добавления, кол-во векторов -
+     * наибольший из размеров. Недостающие позиции считаются Unknown.
+     * @param threads Кол-во потоков, 0 - по кол-ву ядер.
+     * @return Значения выходов в порядке добавления.
+     * @throws std::invalid_argument Если кол-во значений не равно кол-ву входов.
+     * @throws std::runtime_error Если в схеме есть цикл или ссылка
+     * на несуществующий сигнал.
+     */
+    std::vector<TritSet> simulate(const std::vector<TritSet>& inputs, size_t threads = 1) const;
+
+private:
+    
+    /**
+     * Сигнал: вход схемы или выход элемента.
+     */
+    struct Signal {
+        bool input;
+        TritGateType type;
+        size_t first; // Первый вход в fanins
+        size_t count;
+    };
+    
+    /**
+     * Инструкция моделирования над буферами сигналов.
+     */
+    struct Instruction {
+        TritGateType type;
+        size_t result;
+        size_t first; // Первый буфер входа в operands
+        size_t count;
+    };
+    
+    /**
+     * Схема, подготовленная к моделированию.
+     */
+    struct Program {
+        std::vector<Instruction> instructions;
+        std::vector<size_t> operands;
+        std::vector<size_t> inputs;  // Буферы входов
+        std::vector<size_t> outputs; // Буферы выходов
+        size_t buffers;
+    };
+    
+    std::vector<Signal> signals;
+    std::vector<size_t> fanins;
+    std::vector<size_t> inputs;
+    std::vector<size_t> outputs;
+    
+    /**
+     * Уровни сигналов и порядок элементов по уровням.
+     * @param levels Уровень каждого сигнала.
+     * @return Номера сигналов элементов по возрастанию уровня.
+     */
+    std::vector<size_t> levelize(std::vector<size_t>& levels) const;
+    
+    Program compile() const;
+    
+    /**
+     * Моделирует блок векторов.
+     * @param buffers Буферы сигналов по blockWords слов.
+     */
+    void simulateBlock(const Program& program, const std::vector<TritSet>& values,
+                       std::vector<std::vector<uint>>& results,
+                       size_t block, size_t wordsCount, uint* buffers) const;
+};
+
+#endif /* TritCircuit_h */
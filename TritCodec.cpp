@@ -0,0 +1,342 @@
+//
+//  TritCodec.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "TritCodec.h"
+#include "TritWord.h"
+
+#define TRIT_CODEC_MAGIC "TRIZ"
+#define TRIT_CODEC_VERSION 1
+#define TRIT_CODEC_HEADER_SIZE 28
+
+/** Серии короче этой длины дешевле хранить упакованными тритами. */
+#define MIN_RUN 12
+
+/** Максимальное кол-во тритов в одной команде упакованных тритов. */
+#define MAX_LITERAL 128
+
+#define RUN_TAG 0x80
+
+/** Цифра троичной упаковки (значение Trit) для кода трита в хранилище. */
+static const uint8_t CODE_DIGITS[] = {Unknown, False, True, 0};
+
+/** Код трита в хранилище для цифры троичной упаковки. */
+static const uint DIGIT_CODES[] = {0b01, 0b00, 0b10};
+
+/**
+ * Таблица распаковки: байт -> пять тритов в формате хранилища.
+ */
+struct TritCodecTable {
+    uint16_t literals[243];
+    
+    TritCodecTable() {
+        for (uint value = 0; value < 243; value++) {
+            uint digits = value;
+            literals[value] = 0;
+            for (size_t i = 0; i < 5; i++, digits /= 3)
+                literals[value] |= DIGIT_CODES[digits % 3] << (i * 2);
+        }
+    }
+};
+
+static const TritCodecTable table;
+
+static void putLE(std::vector<uint8_t>& out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++, value >>= 8)
+        out.push_back((uint8_t) value);
+}
+
+static uint64_t getLE(const uint8_t* data, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = bytes; i > 0; i--)
+        value = (value << 8) | data[i - 1];
+    return value;
+}
+
+static void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t) (value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t) value);
+}
+
+static uint tritCode(const uint* words, size_t pos) {
+    return (words[pos / TRITS_PER_WORD] >> (pos % TRITS_PER_WORD * 2)) & 0b11;
+}
+
+/**
+ * Длина серии тритов с данным кодом, начиная с позиции pos.
+ * Слова, целиком состоящие из этого трита, пропускаются сразу.
+ */
+static size_t runLength(const uint* words, size_t pos, size_t end, uint code) {
+    size_t start = pos;
+    uint fill = code * FALSE_PLANE;
+    
+    while (pos < end) {
+        if (pos % TRITS_PER_WORD == 0 && end - pos >= TRITS_PER_WORD
+            && words[pos / TRITS_PER_WORD] == fill) {
+            pos += TRITS_PER_WORD;
+            continue;
+        }
+        if (tritCode(words, pos) != code)
+            break;
+        pos++;
+    }
+    
+    return pos - start;
+}
+
+static void encodeLiterals(const uint* words, size_t begin, size_t end, std::vector<uint8_t>& out) {
+    while (begin < end) {
+        size_t count = end - begin < MAX_LITERAL ? end - begin : MAX_LITERAL;
+        out.push_back((uint8_t) (count - 1));
+        
+        for (size_t i = 0; i < count; i += 5) {
+            uint value = 0;
+            for (size_t j = i + 5; j > i; j--)
+                value = value * 3 + (j - 1 < count ? CODE_DIGITS[tritCode(words, begin + j - 1)] : 0);
+            out.push_back((uint8_t) value);
+        }
+        
+        begin += count;
+    }
+}
+
+static void encodeBlock(const uint* words, size_t begin, size_t end, std::vector<uint8_t>& out) {
+    size_t pos = begin;
+    size_t literals = begin; // Начало еще не записанных тритов
+    
+    while (pos < end) {
+        uint code = tritCode(words, pos);
+        size_t run = runLength(words, pos, end, code);
+        
+        if (run >= MIN_RUN) {
+            encodeLiterals(words, literals, pos, out);
+            out.push_back(RUN_TAG | CODE_DIGITS[code]);
+            putVarint(out, run);
+            literals = pos + run;
+        }
+        
+        pos += run;
+    }
+    
+    encodeLiterals(words, literals, end, out);
+}
+
+std::vector<uint8_t> tritSetCompress(const TritSet& set, size_t blockTrits) {
+    // Размер блока хранится в заголовке в 32 битах
+    if (blockTrits > UINT32_MAX / TRITS_PER_WORD * TRITS_PER_WORD)
+        throw std::invalid_argument("trit codec block size does not fit in 32 bits");
+    
+    blockTrits = tritWordsCount(blockTrits ? blockTrits : 1) * TRITS_PER_WORD;
+    
+    const uint* words = set.words().data();
+    size_t size = set.size();
+    size_t blocks = (size + blockTrits - 1) / blockTrits;
+    
+    std::vector<uint8_t> out(TRIT_CODEC_MAGIC, TRIT_CODEC_MAGIC + 4);
+    putLE(out, TRIT_CODEC_VERSION, 2);
+    putLE(out, 0, 2);
+    putLE(out, blockTrits, 4);
+    putLE(out, size, 8);
+    putLE(out, blocks, 8);
+    
+    size_t table = out.size();
+    out.resize(table + (blocks + 1) * 8);
+    size_t data = out.size();
+    
+    for (size_t i = 0; i < blocks; i++) {
+        size_t begin = i * blockTrits;
+        size_t end = size - begin < blockTrits ? size : begin + blockTrits;
+        
+        uint64_t offset = out.size() - data;
+        for (size_t byte = 0; byte < 8; byte++)
+            out[table + i * 8 + byte] = (uint8_t) (offset >> (byte * 8));
+        
+        encodeBlock(words, begin, end, out);
+    }
+    
+    uint64_t offset = out.size() - data;
+    for (size_t byte = 0; byte < 8; byte++)
+        out[table + blocks * 8 + byte] = (uint8_t) (offset >> (byte * 8));
+    
+    return out;
+}
+
+TritSet tritSetDecompress(const uint8_t* data, size_t size, size_t threads) {
+    return CompressedTritSet(data, size).decompress(threads);
+}
+
+CompressedTritSet::CompressedTritSet(const uint8_t* data, size_t size) {
+    if (size < TRIT_CODEC_HEADER_SIZE || std::memcmp(data, TRIT_CODEC_MAGIC, 4)
+        || getLE(data + 4, 2) != TRIT_CODEC_VERSION)
+        throw std::runtime_error("not a compressed trit set");
+    
+    blockSize = getLE(data + 8, 4);
+    tritsCount = getLE(data + 12, 8);
+    count = getLE(data + 20, 8);
+    
+    if (!blockSize || blockSize % TRITS_PER_WORD
+        || count != (tritsCount + blockSize - 1) / blockSize
+        || (size - TRIT_CODEC_HEADER_SIZE) / 8 < count + 1)
+        throw std::runtime_error("corrupted compressed trit set header");
+    
+    offsets = data + TRIT_CODEC_HEADER_SIZE;
+    blocks = offsets + (count + 1) * 8;
+    
+    if (getLE(offsets + count * 8, 8) > (size_t) (data + size - blocks))
+        throw std::runtime_error("compressed trit set is incomplete");
+}
+
+size_t CompressedTritSet::size() const {
+    return tritsCount;
+}
+
+size_t CompressedTritSet::blockTrits() const {
+    return blockSize;
+}
+
+size_t CompressedTritSet::blocksCount() const {
+    return count;
+}
+
+TritSet CompressedTritSet::block(size_t index) const {
+    if (index >= count)
+        throw std::out_of_range("compressed trit set block out of range");
+    
+    size_t trits = tritsCount - index * blockSize;
+    std::vector<uint> words(tritWordsCount(trits < blockSize ? trits : blockSize));
+    decodeBlock(index, words.data());
+    
+    return TritSet::fromWords(std::move(words));
+}
+
+TritSet CompressedTritSet::decompress(size_t threads) const {
+    std::vector<uint> words(tritWordsCount(tritsCount));
+    size_t blockWords = blockSize / TRITS_PER_WORD;
+    
+    if (!threads)
+        threads = std::thread::hardware_concurrency();
+    if (threads > count)
+        threads = count;
+    
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; i++)
+            decodeBlock(i, words.data() + i * blockWords);
+        return TritSet::fromWords(std::move(words));
+    }
+    
+    // Блоки независимы и пишут в непересекающиеся слова хранилища
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(threads);
+    
+    for (size_t t = 0; t < threads; t++)
+        workers.emplace_back([this, t, threads, blockWords, &words, &errors]() {
+            try {
+                for (size_t i = t; i < count; i += threads)
+                    decodeBlock(i, words.data() + i * blockWords);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    
+    for (std::thread& worker : workers)
+        worker.join();
+    
+    for (std::exception_ptr& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+    
+    return TritSet::fromWords(std::move(words));
+}
+
+void CompressedTritSet::decodeBlock(size_t index, uint* words) const {
+    uint64_t begin = getLE(offsets + index * 8, 8);
+    uint64_t finish = getLE(offsets + (index + 1) * 8, 8);
+    
+    if (begin > finish || finish > getLE(offsets + count * 8, 8))
+        throw std::runtime_error("corrupted compressed trit set block");
+    
+    const uint8_t* pos = blocks + begin;
+    const uint8_t* end = blocks + finish;
+    
+    size_t left = tritsCount - index * blockSize;
+    if (left > blockSize)
+        left = blockSize;
+    
+    // Триты дописываются в накопитель и сбрасываются в хранилище по слову
+    uint64_t acc = 0;
+    size_t bits = 0;
+    
+    auto put = [&](uint64_t pattern, size_t trits) {
+        acc |= (pattern & (((uint64_t) 1 << (trits * 2)) - 1)) << bits;
+        bits += trits * 2;
+        if (bits >= 32) {
+            *words++ = (uint) acc;
+            acc >>= 32;
+            bits -= 32;
+        }
+    };
+    
+    while (pos < end) {
+        uint8_t tag = *pos++;
+        
+        if (!(tag & RUN_TAG)) {
+            size_t trits = (size_t) tag + 1;
+            if (trits > left || (size_t) (end - pos) < (trits + 4) / 5)
+                throw std::runtime_error("corrupted compressed trit set block");
+            
+            left -= trits;
+            for (; trits; pos++) {
+                if (*pos >= 243)
+                    throw std::runtime_error("corrupted compressed trit set block");
+                size_t part = trits < 5 ? trits : 5;
+                put(table.literals[*pos], part);
+                trits -= part;
+            }
+            continue;
+        }
+        
+        if (tag > (RUN_TAG | True))
+            throw std::runtime_error("corrupted compressed trit set block");
+        
+        uint64_t trits = 0;
+        for (size_t shift = 0; ; shift += 7) {
+            if (pos == end || shift > 63)
+                throw std::runtime_error("corrupted compressed trit set block");
+            trits |= (uint64_t) (*pos & 0x7F) << shift;
+            if (!(*pos++ & 0x80))
+                break;
+        }
+        
+        if (trits > left)
+            throw std::runtime_error("corrupted compressed trit set block");
+        left -= trits;
+        
+        uint fill = DIGIT_CODES[tag & 0b11] * FALSE_PLANE;
+        
+        for (; trits && bits; trits--)
+            put(fill, 1);
+        for (; trits >= TRITS_PER_WORD; trits -= TRITS_PER_WORD)
+            *words++ = fill;
+        if (trits)
+            put(fill, trits);
+    }
+    
+    if (left)
+        throw std::runtime_error("corrupted compressed trit set block");
+    
+    if (bits)
+        *words = (uint) acc;
+}
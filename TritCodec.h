@@ -0,0 +1,119 @@
+//
+//  TritCodec.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritCodec_h
+#define TritCodec_h
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "TritSet.h"
+
+/**
+ * Сжатие наборов тритов.
+ *
+ * Набор делится на блоки по blockTrits тритов, каждый блок сжимается
+ * независимо от остальных. Внутри блока серии одинаковых тритов
+ * кодируются значением и длиной, а остальные триты упаковываются
+ * по пять в байт (3^5 = 243 < 256), то есть 1.6 бита на трит.
+ *
+ * Формат (все числа little-endian):
+ * заголовок {"TRIZ", версия u16, 0 u16, blockTrits u32, тритов u64, блоков u64},
+ * таблица смещений блоков (блоков + 1) x u64 от конца таблицы, данные блоков.
+ *
+ * Блок - последовательность команд:
+ * 0nnnnnnn - n + 1 тритов, упакованных по пять в байт;
+ * 100000vv, длина varint - серия из длины тритов со значением vv (Trit).
+ */
+
+/** Размер блока по умолчанию. */
+#define TRIT_CODEC_BLOCK 65536
+
+/**
+ * Сжимает набор тритов.
+ * @param set Набор тритов.
+ * @param blockTrits Кол-во тритов в блоке, округляется вверх до целого слова.
+ * @return Сжатые данные.
+ * @throws std::invalid_argument Если блок не помещается в 32 бита заголовка.
+ */
+std::vector<uint8_t> tritSetCompress(const TritSet& set, size_t blockTrits = TRIT_CODEC_BLOCK);
+
+/**
+ * Распаковывает набор тритов.
+ * @param data Сжатые данные.
+ * @param size Размер сжатых данных в байтах.
+ * @param threads Кол-во потоков, 0 - по кол-ву ядер.
+ * @return Набор тритов.
+ * @throws std::runtime_error Если данные повреждены.
+ */
+TritSet tritSetDecompress(const uint8_t* data, size_t size, size_t threads = 1);
+
+/**
+ * Сжатый набор тритов с доступом к отдельным блокам.
+ * Не владеет данными.
+ */
+class CompressedTritSet {
+public:
+    
+    /**
+     * @param data Сжатые данные.
+     * @param size Размер сжатых данных в байтах.
+     * @throws std::runtime_error Если заголовок или таблица блоков повреждены.
+     */
+    CompressedTritSet(const uint8_t* data, size_t size);
+    
+    /**
+     * Размер исходного набора тритов.
+     */
+    size_t size() const;
+    
+    /**
+     * Кол-во тритов в блоке.
+     */
+    size_t blockTrits() const;
+    
+    /**
+     * Кол-во блоков.
+     */
+    size_t blocksCount() const;
+    
+    /**
+     * Распаковывает один блок.
+     * @param index Номер блока.
+     * @return Триты блока, начиная с позиции 0.
+     * @throws std::out_of_range Если номер не меньше кол-ва блоков.
+     * @throws std::runtime_error Если блок поврежден.
+     */
+    TritSet block(size_t index) const;
+    
+    /**
+     * Распаковывает набор тритов целиком.
+     * Блоки распаковываются параллельно прямо в общее хранилище.
+     * @param threads Кол-во потоков, 0 - по кол-ву ядер.
+     * @return Набор тритов.
+     * @throws std::runtime_error Если данные повреждены.
+     */
+    TritSet decompress(size_t threads = 1) const;
+
+private:
+    const uint8_t* blocks;  // Начало данных блоков
+    const uint8_t* offsets; // Таблица смещений блоков
+    size_t tritsCount;
+    size_t blockSize;
+    size_t count;
+    
+    /**
+     * Распаковывает блок в слова хранилища.
+     * @param index Номер блока.
+     * @param words Слова блока, обнуленные.
+     */
+    void decodeBlock(size_t index, uint* words) const;
+};
+
+#endif /* TritCodec_h */
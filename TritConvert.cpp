@@ -0,0 +1,262 @@
+//
+//  TritConvert.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+#include "TritConvert.h"
+#include "TritWord.h"
+
+/**
+ * Формат массива значений.
+ */
+enum ValuesFormat {
+    Int8Values, // -1/0/+1
+    TritValues  // Значения Trit
+};
+
+/**
+ * Значение Unknown в массиве данного формата.
+ */
+static uint8_t unknownValue(ValuesFormat format) {
+    return format == Int8Values ? 0 : Unknown;
+}
+
+/**
+ * Упаковывает TRITS_PER_WORD значений в одно слово хранилища.
+ */
+static uint packWord(const uint8_t* values, ValuesFormat format) {
+#ifdef __SSE2__
+    __m128i bytes = _mm_loadu_si128((const __m128i*) values);
+    __m128i isFalse, isTrue;
+    
+    if (format == Int8Values) {
+        isFalse = _mm_cmplt_epi8(bytes, _mm_setzero_si128());
+        isTrue = _mm_cmpgt_epi8(bytes, _mm_setzero_si128());
+    } else {
+        isFalse = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(False));
+        isTrue = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(True));
+    }
+    
+    return wordSpreadBits(_mm_movemask_epi8(isFalse))
+        | (wordSpreadBits(_mm_movemask_epi8(isTrue)) << 1);
+#else
+    uint word = 0;
+    
+    for (size_t i = 0; i < TRITS_PER_WORD; i++) {
+        uint isFalse, isTrue;
+        
+        if (format == Int8Values) {
+            isFalse = (int8_t) values[i] < 0;
+            isTrue = (int8_t) values[i] > 0;
+        } else {
+            isFalse = values[i] == False;
+            isTrue = values[i] == True;
+        }
+        
+        word |= (isFalse | (isTrue << 1)) << (i * 2);
+    }
+    
+    return word;
+#endif
+}
+
+#ifdef __SSE2__
+/**
+ * Раздвигает 16 бит маски в 16 байт: 0xFF для установленных битов.
+ */
+static __m128i expandMask(uint mask) {
+    const uint64_t spread = 0x0101010101010101ULL;
+    const __m128i bits = _mm_set1_epi64x((long long) 0x8040201008040201ULL);
+    
+    __m128i bytes = _mm_set_epi64x((long long) (((mask >> 8) & 0xFF) * spread),
+                                   (long long) ((mask & 0xFF) * spread));
+    return _mm_cmpeq_epi8(_mm_and_si128(bytes, bits), bits);
+}
+#endif
+
+/**
+ * Распаковывает слово хранилища в TRITS_PER_WORD значений.
+ */
+static void unpackWord(uint word, uint8_t* values, ValuesFormat format) {
+#ifdef __SSE2__
+    __m128i isFalse = expandMask(wordCompactBits(word));
+    __m128i isTrue = expandMask(wordCompactBits(word >> 1));
+    
+    // False: -1, Unknown: 0, True: +1
+    __m128i bytes = _mm_sub_epi8(isFalse, isTrue);
+    if (format == TritValues)
+        bytes = _mm_add_epi8(bytes, _mm_set1_epi8(Unknown));
+    
+    _mm_storeu_si128((__m128i*) values, bytes);
+#else
+    uint8_t base = unknownValue(format);
+    
+    for (size_t i = 0; i < TRITS_PER_WORD; i++, word >>= 2)
+        values[i] = base - (word & 1) + ((word >> 1) & 1);
+#endif
+}
+
+static TritSet fromValues(const uint8_t* values, size_t count, ValuesFormat format) {
+    std::vector<uint> words(tritWordsCount(count));
+    size_t full = count / TRITS_PER_WORD;
+    
+    for (size_t i = 0; i < full; i++)
+        words[i] = packWord(values + i * TRITS_PER_WORD, format);
+    
+    size_t tail = count % TRITS_PER_WORD;
+    if (tail) {
+        uint8_t buffer[TRITS_PER_WORD];
+        std::memset(buffer, unknownValue(format), sizeof(buffer));
+        std::memcpy(buffer, values + full * TRITS_PER_WORD, tail);
+        words[full] = packWord(buffer, format);
+    }
+    
+    return TritSet::fromWords(std::move(words));
+}
+
+static void toValues(const TritSet& set, uint8_t* values, size_t count, ValuesFormat format) {
+    const std::vector<uint>& words = set.words();
+    size_t full = count / TRITS_PER_WORD;
+    
+    for (size_t i = 0; i < full; i++)
+        unpackWord(i < words.size() ? words[i] : 0, values + i * TRITS_PER_WORD, format);
+    
+    size_t tail = count % TRITS_PER_WORD;
+    if (tail) {
+        uint8_t buffer[TRITS_PER_WORD];
+        unpackWord(full < words.size() ? words[full] : 0, buffer, format);
+        std::memcpy(values + full * TRITS_PER_WORD, buffer, tail);
+    }
+}
+
+TritSet tritSetFromInt8(const int8_t* values, size_t count) {
+    return fromValues((const uint8_t*) values, count, Int8Values);
+}
+
+void tritSetToInt8(const TritSet& set, int8_t* values, size_t count) {
+    toValues(set, (uint8_t*) values, count, Int8Values);
+}
+
+TritSet tritSetFromBytes(const uint8_t* codes, size_t count) {
+    return fromValues(codes, count, TritValues);
+}
+
+void tritSetToBytes(const TritSet& set, uint8_t* codes, size_t count) {
+    toValues(set, codes, count, TritValues);
+}
+
+TritSet tritSetFromTrits(const std::vector<Trit>& trits) {
+    std::vector<uint> words(tritWordsCount(trits.size()));
+    uint8_t buffer[TRITS_PER_WORD];
+    
+    // Trit занимает sizeof(int) байт: триты слова сужаются в байты
+    // и упаковываются тем же ядром, что и tritSetFromBytes
+    for (size_t i = 0; i < words.size(); i++) {
+        size_t begin = i * TRITS_PER_WORD;
+        size_t count = std::min(TRITS_PER_WORD, trits.size() - begin);
+        
+        std::memset(buffer, Unknown, sizeof(buffer));
+        for (size_t j = 0; j < count; j++)
+            buffer[j] = (uint8_t) trits[begin + j];
+        
+        words[i] = packWord(buffer, TritValues);
+    }
+    
+    return TritSet::fromWords(std::move(words));
+}
+
+std::vector<Trit> tritSetToTrits(const TritSet& set) {
+    std::vector<Trit> trits(set.size());
+    const std::vector<uint>& words = set.words();
+    uint8_t buffer[TRITS_PER_WORD];
+    
+    for (size_t begin = 0; begin < trits.size(); begin += TRITS_PER_WORD) {
+        size_t count = std::min(TRITS_PER_WORD, trits.size() - begin);
+        
+        unpackWord(words[begin / TRITS_PER_WORD], buffer, TritValues);
+        for (size_t j = 0; j < count; j++)
+            trits[begin + j] = Trit(buffer[j]);
+    }
+    
+    return trits;
+}
+
+/**
+ * Раздвигает 16 бит маски в четные биты слова, при наличии BMI2 - через pdep.
+ */
+static uint spreadBits(uint bits) {
+#ifdef __BMI2__
+    return _pdep_u32(bits, FALSE_PLANE);
+#else
+    return wordSpreadBits(bits);
+#endif
+}
+
+/**
+ * Собирает четные биты слова в 16 бит маски, при наличии BMI2 - через pext.
+ */
+static uint compactBits(uint word) {
+#ifdef __BMI2__
+    return _pext_u32(word, FALSE_PLANE);
+#else
+    return wordCompactBits(word);
+#endif
+}
+
+TritSet tritSetFromMasks(const uint64_t* known, const uint64_t* value, size_t count) {
+    std::vector<uint> words(tritWordsCount(count));
+    
+    // Каждые 16 бит масок дают одно слово хранилища
+    for (size_t i = 0; i < words.size(); i++) {
+        size_t shift = i * TRITS_PER_WORD % 64;
+        uint knownBits = (uint) (known[i * TRITS_PER_WORD / 64] >> shift) & 0xFFFF;
+        uint valueBits = (uint) (value[i * TRITS_PER_WORD / 64] >> shift) & 0xFFFF;
+        
+        words[i] = spreadBits(knownBits & ~valueBits) | (spreadBits(knownBits & valueBits) << 1);
+    }
+    
+    if (count % TRITS_PER_WORD)
+        words.back() &= tritWordLowMask(count % TRITS_PER_WORD);
+    
+    return TritSet::fromWords(std::move(words));
+}
+
+void tritSetToMasks(const TritSet& set, uint64_t* known, uint64_t* value, size_t count) {
+    const std::vector<uint>& words = set.words();
+    size_t masksCount = (count + 63) / 64;
+    
+    for (size_t i = 0; i < masksCount; i++) {
+        uint64_t knownBits = 0, valueBits = 0;
+        
+        for (size_t j = 0; j < 64 / TRITS_PER_WORD; j++) {
+            size_t index = i * (64 / TRITS_PER_WORD) + j;
+            uint word = index < words.size() ? words[index] : 0;
+            uint trues = compactBits(word >> 1);
+            
+            knownBits |= (uint64_t) (compactBits(word) | trues) << (j * TRITS_PER_WORD);
+            valueBits |= (uint64_t) trues << (j * TRITS_PER_WORD);
+        }
+        
+        if (i == masksCount - 1 && count % 64) {
+            knownBits &= ((uint64_t) 1 << (count % 64)) - 1;
+            valueBits &= ((uint64_t) 1 << (count % 64)) - 1;
+        }
+        
+        known[i] = knownBits;
+        value[i] = valueBits;
+    }
+}
@@ -0,0 +1,127 @@
+//
+//  TritConvert.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritConvert_h
+#define TritConvert_h
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TritSet.h"
+
+/**
+ * Пакетное преобразование между наборами тритов и массивами значений.
+ * Триты обрабатываются по 16 за раз (одно слово хранилища): при наличии
+ * SSE2 байты сравниваются векторно, а маски раздвигаются в слово.
+ */
+
+/**
+ * Создает набор тритов из массива -1/0/+1.
+ * @param values Значения: отрицательные - False, 0 - Unknown, положительные - True.
+ * @param count Кол-во значений.
+ * @return Набор тритов.
+ */
+TritSet tritSetFromInt8(const int8_t* values, size_t count);
+
+/**
+ * Записывает триты [0, count) в массив -1/0/+1.
+ * @param set Набор тритов.
+ * @param values Массив для записи, не меньше count элементов.
+ * @param count Кол-во записываемых тритов, триты после size() - 0.
+ */
+void tritSetToInt8(const TritSet& set, int8_t* values, size_t count);
+
+/**
+ * Создает набор тритов из массива значений Trit, хранящихся в байтах.
+ * @param codes Значения False (0), Unknown (1) или True (2).
+ * Остальные значения считаются Unknown.
+ * @param count Кол-во значений.
+ * @return Набор тритов.
+ */
+TritSet tritSetFromBytes(const uint8_t* codes, size_t count);
+
+/**
+ * Записывает триты [0, count) в массив значений Trit, хранящихся в байтах.
+ * @see tritSetToInt8(const TritSet&, int8_t*, size_t)
+ */
+void tritSetToBytes(const TritSet& set, uint8_t* codes, size_t count);
+
+/**
+ * Создает набор тритов из массива тритов.
+ * @param trits Триты.
+ * @return Набор тритов.
+ */
+TritSet tritSetFromTrits(const std::vector<Trit>& trits);
+
+/**
+ * Массив тритов [0, set.size()).
+ * @param set Набор тритов.
+ * @return Триты.
+ */
+std::vector<Trit> tritSetToTrits(const TritSet& set);
+
+/**
+ * Создает набор тритов из пары битовых масок.
+ * @param known Биты известных тритов, бит i - трит i.
+ * @param value Биты значений: 1 - True, 0 - False. Для неизвестных тритов не важен.
+ * @param count Кол-во тритов, маски содержат не меньше (count + 63) / 64 слов.
+ * @return Набор тритов.
+ */
+TritSet tritSetFromMasks(const uint64_t* known, const uint64_t* value, size_t count);
+
+/**
+ * Записывает триты [0, count) в пару битовых масок.
+ * @param set Набор тритов.
+ * @param known Маска известных тритов, (count + 63) / 64 слов.
+ * @param value Маска тритов True, (count + 63) / 64 слов.
+ * @param count Кол-во тритов, биты после count обнуляются.
+ */
+void tritSetToMasks(const TritSet& set, uint64_t* known, uint64_t* value, size_t count);
+
+/**
+ * Разбивает bitset на слова по 64 бита.
+ */
+template <size_t N>
+std::vector<uint64_t> bitsetWords(std::bitset<N> bits) {
+    const std::bitset<N> low(~(unsigned long long) 0);
+    std::vector<uint64_t> words((N + 63) / 64);
+    
+    for (size_t i = 0; i < words.size(); i++, bits >>= 64)
+        words[i] = (bits & low).to_ullong();
+    
+    return words;
+}
+
+/**
+ * @see tritSetFromMasks(const uint64_t*, const uint64_t*, size_t)
+ */
+template <size_t N>
+TritSet tritSetFromMasks(const std::bitset<N>& known, const std::bitset<N>& value) {
+    return tritSetFromMasks(bitsetWords(known).data(), bitsetWords(value).data(), N);
+}
+
+/**
+ * @see tritSetToMasks(const TritSet&, uint64_t*, uint64_t*, size_t)
+ */
+template <size_t N>
+void tritSetToMasks(const TritSet& set, std::bitset<N>& known, std::bitset<N>& value) {
+    std::vector<uint64_t> knownWords((N + 63) / 64), valueWords((N + 63) / 64);
+    tritSetToMasks(set, knownWords.data(), valueWords.data(), N);
+    
+    known.reset();
+    value.reset();
+    
+    for (size_t i = knownWords.size(); i > 0; i--) {
+        known = (known << 64) | std::bitset<N>(knownWords[i - 1]);
+        value = (value << 64) | std::bitset<N>(valueWords[i - 1]);
+    }
+}
+
+#endif /* TritConvert_h */
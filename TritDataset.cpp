@@ -0,0 +1,215 @@
+//
+//  TritDataset.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include "TritDataset.h"
+#include "TritWord.h"
+
+/**
+ * Проверяет заголовок набора наборов.
+ * @param header Заголовок.
+ * @param size Размер файла в байтах.
+ * @return Корректен ли заголовок.
+ */
+static bool datasetHeaderValid(const TritDatasetHeader& header, uint64_t size) {
+    if (std::memcmp(header.magic, TRIT_DATASET_MAGIC, sizeof(header.magic)))
+        return false;
+    
+    // Однобайтовое поле читается одинаково на любой платформе, а остальные
+    // поля, индекс и слова наборов записаны в порядке байт записавшей платформы
+    if (header.byteOrder != tritNativeByteOrder())
+        return false;
+    
+    if (header.version != TRIT_DATASET_VERSION || header.wordSize != sizeof(uint))
+        return false;
+    
+    if (header.indexOffset < sizeof(TritDatasetHeader) || header.indexOffset % 8
+        || header.indexOffset > size)
+        return false;
+    
+    return header.setsCount <= (size - header.indexOffset) / sizeof(TritDatasetEntry);
+}
+
+/**
+ * Смещение индекса: сразу после слов наборов, выровненное для uint64_t.
+ */
+static uint64_t datasetIndexOffset(uint64_t payloadWords) {
+    return (sizeof(TritDatasetHeader) + payloadWords * sizeof(uint) + 7) / 8 * 8;
+}
+
+TritDataset::TritDataset(const std::string& path)
+    : file(std::make_shared<MappedFile>(path)) {
+    
+    const TritDatasetHeader* header = (const TritDatasetHeader*) file->data();
+    
+    if (file->size() < sizeof(TritDatasetHeader) || !datasetHeaderValid(*header, file->size()))
+        throw std::runtime_error(path + ": corrupted trit dataset file");
+    
+    index = (const TritDatasetEntry*) (file->data() + header->indexOffset);
+    payload = (const uint*) (file->data() + sizeof(TritDatasetHeader));
+    setsCount = header->setsCount;
+    payloadWords = (header->indexOffset - sizeof(TritDatasetHeader)) / sizeof(uint);
+}
+
+size_t TritDataset::size() const {
+    return setsCount;
+}
+
+MappedTritSet TritDataset::operator[](size_t index) const {
+    const TritDatasetEntry& set = entry(index);
+    return MappedTritSet(file, payload + set.wordOffset, set.tritsCount, set.checksum);
+}
+
+size_t TritDataset::tritsCount(size_t index) const {
+    return entry(index).tritsCount;
+}
+
+size_t TritDataset::cardinality(size_t index, Trit trit) const {
+    const TritDatasetEntry& set = entry(index);
+    
+    switch (trit) {
+        case False:
+            return set.falseCount;
+        case True:
+            return set.trueCount;
+        default:
+            return set.tritsCount - set.falseCount - set.trueCount;
+    }
+}
+
+const TritDatasetEntry& TritDataset::entry(size_t index) const {
+    if (index >= setsCount)
+        throw std::out_of_range("trit dataset index out of range");
+    
+    const TritDatasetEntry& set = this->index[index];
+    
+    uint64_t words = tritWordsCount(set.tritsCount);
+    if (set.wordOffset > payloadWords || words > payloadWords - set.wordOffset)
+        throw std::runtime_error("corrupted trit dataset index");
+    
+    if (set.falseCount > set.tritsCount || set.trueCount > set.tritsCount - set.falseCount)
+        throw std::runtime_error("corrupted trit dataset index");
+    
+    return set;
+}
+
+TritDatasetWriter::TritDatasetWriter(const std::string& path)
+    : path(path), payloadWords(0), modified(true) {
+    
+    stream.open(path, std::ios::binary | std::ios::in | std::ios::out);
+    
+    if (!stream) {
+        // Файла еще нет: создаем его
+        stream.clear();
+        stream.open(path, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+        if (!stream)
+            throw std::system_error(errno, std::generic_category(), path);
+        return;
+    }
+    
+    stream.seekg(0, std::ios::end);
+    uint64_t size = stream.tellg();
+    stream.seekg(0);
+    
+    if (!size)
+        return;
+    
+    TritDatasetHeader header;
+    if (size < sizeof(header) || !stream.read((char*) &header, sizeof(header))
+        || !datasetHeaderValid(header, size))
+        throw std::runtime_error(path + ": corrupted trit dataset file");
+    
+    index.resize(header.setsCount);
+    stream.seekg(header.indexOffset);
+    if (!stream.read((char*) index.data(), index.size() * sizeof(TritDatasetEntry)))
+        throw std::runtime_error(path + ": corrupted trit dataset file");
+    
+    // Новые слова пишутся после старого индекса, который остается
+    // действительным, пока не записан новый заголовок
+    uint64_t indexEnd = header.indexOffset + index.size() * sizeof(TritDatasetEntry);
+    payloadWords = (indexEnd - sizeof(TritDatasetHeader)) / sizeof(uint);
+    modified = false;
+}
+
+TritDatasetWriter::~TritDatasetWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Деструктор не должен бросать исключения, ошибку можно получить из close()
+    }
+}
+
+size_t TritDatasetWriter::append(const TritSet& set) {
+    TritDatasetEntry entry;
+    entry.wordOffset = payloadWords;
+    entry.tritsCount = set.size();
+    entry.falseCount = set.cardinality(False);
+    entry.trueCount = set.cardinality(True);
+    
+    size_t words = tritWordsCount(entry.tritsCount);
+    entry.checksum = tritChecksum(set.words().data(), words);
+    
+    // Слова пишутся за концом данных, на которые ссылается заголовок
+    stream.seekp(sizeof(TritDatasetHeader) + payloadWords * sizeof(uint));
+    if (!stream.write((const char*) set.words().data(), words * sizeof(uint)))
+        throw std::system_error(errno, std::generic_category(), path);
+    
+    payloadWords += words;
+    index.push_back(entry);
+    modified = true;
+    
+    return index.size() - 1;
+}
+
+size_t TritDatasetWriter::size() const {
+    return index.size();
+}
+
+void TritDatasetWriter::close() {
+    if (!stream.is_open())
+        return;
+    
+    if (!modified) {
+        stream.close();
+        return;
+    }
+    
+    TritDatasetHeader header;
+    std::memcpy(header.magic, TRIT_DATASET_MAGIC, sizeof(header.magic));
+    header.version = TRIT_DATASET_VERSION;
+    header.wordSize = sizeof(uint);
+    header.byteOrder = tritNativeByteOrder();
+    header.setsCount = index.size();
+    header.indexOffset = datasetIndexOffset(payloadWords);
+    header.reserved = 0;
+    
+    const char padding[8] = {};
+    uint64_t payloadEnd = sizeof(TritDatasetHeader) + payloadWords * sizeof(uint);
+    
+    // Заголовок пишется последним: до этого файл описывает прежнее состояние
+    stream.seekp(payloadEnd);
+    stream.write(padding, header.indexOffset - payloadEnd);
+    stream.write((const char*) index.data(), index.size() * sizeof(TritDatasetEntry));
+    stream.flush();
+    
+    if (stream) {
+        stream.seekp(0);
+        stream.write((const char*) &header, sizeof(header));
+        stream.flush();
+    }
+    
+    bool failed = !stream;
+    stream.close();
+    
+    if (failed)
+        throw std::system_error(errno, std::generic_category(), path);
+}
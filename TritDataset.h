@@ -0,0 +1,135 @@
+//
+//  TritDataset.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritDataset_h
+#define TritDataset_h
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "MappedTritSet.h"
+#include "TritFormat.h"
+#include "TritSet.h"
+
+/**
+ * Набор наборов тритов, хранящихся подряд в одном файле.
+ * Файл отображается в память, индекс с размерами и кол-вом тритов
+ * каждого набора лежит в конце файла (формат описан в TritFormat.h).
+ */
+class TritDataset {
+public:
+    
+    /**
+     * Отображает набор наборов из файла.
+     * @param path Путь к файлу.
+     * @throws std::system_error Если файл не удалось открыть.
+     * @throws std::runtime_error Если файл поврежден или записан
+     * с другим размером слова или порядком байт.
+     */
+    explicit TritDataset(const std::string& path);
+    
+    /**
+     * Кол-во наборов тритов.
+     */
+    size_t size() const;
+    
+    /**
+     * Набор тритов с данным номером. Не копирует данные и не выделяет
+     * память в куче: набор ссылается на общее отображение файла.
+     * @param index Номер набора.
+     * @return Набор тритов.
+     * @throws std::out_of_range Если номер больше кол-ва наборов.
+     * @throws std::runtime_error Если запись индекса повреждена.
+     */
+    MappedTritSet operator[](size_t index) const;
+    
+    /**
+     * Размер набора тритов с данным номером.
+     * @param index Номер набора.
+     * @return Индекс последнего не Unknown трита + 1.
+     * @throws std::out_of_range Если номер больше кол-ва наборов.
+     * @throws std::runtime_error Если запись индекса повреждена.
+     */
+    size_t tritsCount(size_t index) const;
+    
+    /**
+     * Кол-во тритов данного значения в наборе, без чтения самого набора.
+     * @see TritSet::cardinality(Trit)
+     * @throws std::out_of_range Если номер больше кол-ва наборов.
+     * @throws std::runtime_error Если запись индекса повреждена.
+     */
+    size_t cardinality(size_t index, Trit trit) const;
+
+private:
+    std::shared_ptr<const MappedFile> file;
+    const TritDatasetEntry* index;
+    const uint* payload;
+    size_t setsCount;
+    size_t payloadWords;
+    
+    const TritDatasetEntry& entry(size_t index) const;
+};
+
+/**
+ * Запись набора наборов тритов. Наборы только добавляются в конец,
+ * уже записанные данные не переписываются: новые слова и индекс пишутся
+ * после прежнего индекса, а заголовок, ссылающийся на новый индекс, -
+ * последним. При сбое до close() файл остается в прежнем состоянии.
+ * Прежний индекс остается в файле неиспользуемым местом.
+ */
+class TritDatasetWriter {
+public:
+    
+    /**
+     * Открывает файл для добавления наборов, создавая его при отсутствии.
+     * @param path Путь к файлу.
+     * @throws std::system_error Если файл не удалось открыть.
+     * @throws std::runtime_error Если существующий файл поврежден.
+     */
+    explicit TritDatasetWriter(const std::string& path);
+    
+    /**
+     * Закрывает файл, если он еще не закрыт.
+     * @see close()
+     */
+    ~TritDatasetWriter();
+    
+    /**
+     * Добавляет набор тритов в конец.
+     * @param set Набор тритов.
+     * @return Номер добавленного набора.
+     * @throws std::system_error Если не удалось записать данные.
+     */
+    size_t append(const TritSet& set);
+    
+    /**
+     * Кол-во наборов тритов, включая добавленные.
+     */
+    size_t size() const;
+    
+    /**
+     * Записывает индекс и заголовок и закрывает файл.
+     * @throws std::system_error Если не удалось записать данные.
+     */
+    void close();
+
+private:
+    std::string path;
+    std::fstream stream;
+    std::vector<TritDatasetEntry> index;
+    uint64_t payloadWords;
+    bool modified; // Нужно ли записать индекс и заголовок
+    
+    TritDatasetWriter(const TritDatasetWriter&) = delete;
+    TritDatasetWriter& operator=(const TritDatasetWriter&) = delete;
+};
+
+#endif /* TritDataset_h */
@@ -0,0 +1,102 @@
+//
+//  TritDistance.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include "TritDistance.h"
+#include "TritWord.h"
+
+/**
+ * Маска младших битов различающихся тритов.
+ */
+static uint differentMask(uint left, uint right) {
+    uint difference = left ^ right;
+    return (difference | (difference >> 1)) & FALSE_PLANE;
+}
+
+/**
+ * Маска младших битов тритов, где один True, а другой False.
+ */
+static uint conflictMask(uint left, uint right) {
+    return (((left >> 1) & right) | ((right >> 1) & left)) & FALSE_PLANE;
+}
+
+template <typename Mask>
+static size_t countWords(const uint* left, size_t leftCount,
+                         const uint* right, size_t rightCount, Mask mask) {
+    size_t common = leftCount < rightCount ? leftCount : rightCount;
+    size_t count = 0;
+    
+    for (size_t i = 0; i < common; i++)
+        count += wordPopcount(mask(left[i], right[i]));
+    for (size_t i = common; i < leftCount; i++)
+        count += wordPopcount(mask(left[i], 0));
+    for (size_t i = common; i < rightCount; i++)
+        count += wordPopcount(mask(0, right[i]));
+    
+    return count;
+}
+
+size_t tritWordsDistance(const uint* left, size_t leftCount,
+                         const uint* right, size_t rightCount, TritMetric metric) {
+    if (metric == TritConflicts)
+        return countWords(left, leftCount, right, rightCount, conflictMask);
+    return countWords(left, leftCount, right, rightCount, differentMask);
+}
+
+size_t tritDistance(const TritSet& left, const TritSet& right) {
+    return tritWordsDistance(left.words().data(), tritWordsCount(left.size()),
+                             right.words().data(), tritWordsCount(right.size()), TritDifferences);
+}
+
+size_t tritConflicts(const TritSet& left, const TritSet& right) {
+    return tritWordsDistance(left.words().data(), tritWordsCount(left.size()),
+                             right.words().data(), tritWordsCount(right.size()), TritConflicts);
+}
+
+double tritJaccard(const TritSet& left, const TritSet& right) {
+    const uint* leftWords = left.words().data();
+    const uint* rightWords = right.words().data();
+    size_t leftCount = tritWordsCount(left.size());
+    size_t rightCount = tritWordsCount(right.size());
+    
+    // Совпадения: оба трита известны и равны, то есть одинаковый ненулевой код
+    size_t matches = countWords(leftWords, leftCount, rightWords, rightCount, [](uint a, uint b) {
+        uint same = a & b;
+        return (same | (same >> 1)) & FALSE_PLANE;
+    });
+    size_t known = countWords(leftWords, leftCount, rightWords, rightCount, [](uint a, uint b) {
+        return tritWordKnown(a | b);
+    });
+    
+    return known ? (double) matches / known : 1.0;
+}
+
+std::vector<size_t> tritDistances(const TritSet& query, const TritSet* const* sets, size_t count,
+                                  TritMetric metric) {
+    std::vector<size_t> result(count);
+    size_t queryCount = tritWordsCount(query.size());
+    
+    for (size_t i = 0; i < count; i++)
+        result[i] = tritWordsDistance(query.words().data(), queryCount, sets[i]->words().data(),
+                                      tritWordsCount(sets[i]->size()), metric);
+    
+    return result;
+}
+
+std::vector<size_t> tritDistances(const TritSet& query, const TritDataset& dataset,
+                                  TritMetric metric) {
+    std::vector<size_t> result(dataset.size());
+    size_t queryCount = tritWordsCount(query.size());
+    
+    for (size_t i = 0; i < result.size(); i++) {
+        MappedTritSet set = dataset[i];
+        result[i] = tritWordsDistance(query.words().data(), queryCount,
+                                      set.words(), set.wordsCount(), metric);
+    }
+    
+    return result;
+}
@@ -0,0 +1,82 @@
+//
+//  TritDistance.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritDistance_h
+#define TritDistance_h
+
+#include <cstddef>
+#include <vector>
+
+#include "TritDataset.h"
+#include "TritSet.h"
+
+/**
+ * Расстояния между наборами тритов.
+ *
+ * Вычисляются пословно: XOR кодов двух слов дает ненулевую пару битов
+ * ровно на различающихся позициях, после чего остается popcount.
+ * Триты за пределами набора считаются Unknown.
+ */
+
+/**
+ * Вид расстояния.
+ */
+enum TritMetric {
+    TritDifferences, // Кол-во различающихся позиций
+    TritConflicts    // Кол-во позиций, где в одном наборе True, а в другом False
+};
+
+/**
+ * Кол-во различающихся позиций (расстояние Хэмминга над тритами).
+ */
+size_t tritDistance(const TritSet& left, const TritSet& right);
+
+/**
+ * Кол-во известных противоречий: позиций, где один трит True, а другой False.
+ */
+size_t tritConflicts(const TritSet& left, const TritSet& right);
+
+/**
+ * Коэффициент Жаккара по известным позициям: кол-во позиций, где оба
+ * трита известны и совпадают, деленное на кол-во позиций, где известен
+ * хотя бы один трит.
+ * @return Сходство от 0 до 1, для двух пустых наборов - 1.
+ */
+double tritJaccard(const TritSet& left, const TritSet& right);
+
+/**
+ * Расстояние между словами хранилища.
+ * @param left Слова левого набора.
+ * @param leftCount Кол-во слов левого набора.
+ * @param right Слова правого набора.
+ * @param rightCount Кол-во слов правого набора.
+ * @param metric Вид расстояния.
+ */
+size_t tritWordsDistance(const uint* left, size_t leftCount,
+                         const uint* right, size_t rightCount, TritMetric metric);
+
+/**
+ * Расстояния от запроса до каждого из наборов.
+ * @param query Запрос.
+ * @param sets Наборы тритов.
+ * @param count Кол-во наборов.
+ * @param metric Вид расстояния.
+ * @return Расстояние до каждого набора в порядке наборов.
+ */
+std::vector<size_t> tritDistances(const TritSet& query, const TritSet* const* sets, size_t count,
+                                  TritMetric metric = TritDifferences);
+
+/**
+ * Расстояния от запроса до каждого набора из файла наборов.
+ * Наборы читаются прямо из отображения файла.
+ * @see tritDistances(const TritSet&, const TritSet* const*, size_t, TritMetric)
+ */
+std::vector<size_t> tritDistances(const TritSet& query, const TritDataset& dataset,
+                                  TritMetric metric = TritDifferences);
+
+#endif /* TritDistance_h */
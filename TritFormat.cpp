@@ -0,0 +1,177 @@
+//
+//  TritFormat.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstring>
+#include <stdexcept>
+
+#include "TritFormat.h"
+#include "TritWord.h"
+
+TritByteOrder tritNativeByteOrder() {
+    const uint16_t probe = 1;
+    uint8_t first;
+    std::memcpy(&first, &probe, 1);
+    return first ? TritLittleEndian : TritBigEndian;
+}
+
+uint64_t tritChecksum(const uint* words, size_t count) {
+    uint64_t low = 0, high = 0;
+    
+    // Откладываем взятие остатка, пока суммы гарантированно не переполнятся
+    const size_t blockSize = 92679;
+    
+    while (count) {
+        size_t block = count < blockSize ? count : blockSize;
+        for (size_t i = 0; i < block; i++) {
+            low += (uint32_t) words[i];
+            high += low;
+        }
+        low %= 0xFFFFFFFF;
+        high %= 0xFFFFFFFF;
+        words += block;
+        count -= block;
+    }
+    
+    return (high << 32) | low;
+}
+
+TritFileHeader tritFileHeader(const TritSet& set) {
+    TritFileHeader header;
+    std::memcpy(header.magic, TRIT_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRIT_FILE_VERSION;
+    header.wordSize = sizeof(uint);
+    header.byteOrder = TritLittleEndian;
+    header.tritsCount = set.size();
+    header.wordsCount = tritWordsCount(set.size());
+    header.checksum = tritChecksum(set.words().data(), header.wordsCount);
+    return header;
+}
+
+static void putLE(uint8_t* bytes, uint64_t value, size_t count) {
+    for (size_t i = 0; i < count; i++, value >>= 8)
+        bytes[i] = (uint8_t) value;
+}
+
+static uint64_t getLE(const uint8_t* bytes, size_t count) {
+    uint64_t value = 0;
+    for (size_t i = count; i > 0; i--)
+        value = (value << 8) | bytes[i - 1];
+    return value;
+}
+
+void tritFileHeaderEncode(const TritFileHeader& header, uint8_t* bytes) {
+    std::memcpy(bytes, header.magic, sizeof(header.magic));
+    putLE(bytes + 4, header.version, 2);
+    bytes[6] = header.wordSize;
+    bytes[7] = header.byteOrder;
+    putLE(bytes + 8, header.tritsCount, 8);
+    putLE(bytes + 16, header.wordsCount, 8);
+    putLE(bytes + 24, header.checksum, 8);
+}
+
+TritFileHeader tritFileHeaderDecode(const uint8_t* bytes) {
+    TritFileHeader header;
+    std::memcpy(header.magic, bytes, sizeof(header.magic));
+    header.version = (uint16_t) getLE(bytes + 4, 2);
+    header.wordSize = bytes[6];
+    header.byteOrder = bytes[7];
+    header.tritsCount = getLE(bytes + 8, 8);
+    header.wordsCount = getLE(bytes + 16, 8);
+    header.checksum = getLE(bytes + 24, 8);
+    return header;
+}
+
+bool tritFileHeaderValid(const TritFileHeader& header, size_t available) {
+    if (std::memcmp(header.magic, TRIT_FILE_MAGIC, sizeof(header.magic)))
+        return false;
+    
+    if (header.version != TRIT_FILE_VERSION || header.wordSize != sizeof(uint))
+        return false;
+    
+    if (header.byteOrder != TritLittleEndian && header.byteOrder != TritBigEndian)
+        return false;
+    
+    if (header.wordsCount != tritWordsCount(header.tritsCount))
+        return false;
+    
+    return header.wordsCount <= available / sizeof(uint);
+}
+
+void tritWordsByteSwap(uint* words, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint word = words[i], swapped = 0;
+        for (size_t byte = 0; byte < sizeof(uint); byte++) {
+            swapped = (swapped << 8) | (word & 0xFF);
+            word >>= 8;
+        }
+        words[i] = swapped;
+    }
+}
+
+TritSet tritSetFromPayload(const TritFileHeader& header, std::vector<uint>&& words) {
+    if (header.byteOrder != tritNativeByteOrder())
+        tritWordsByteSwap(words.data(), words.size());
+    
+    if (tritChecksum(words.data(), words.size()) != header.checksum)
+        throw std::runtime_error("trit set checksum mismatch");
+    
+    return TritSet::fromWords(std::move(words));
+}
+
+TritSetDecoder::TritSetDecoder() : received(0) {}
+
+size_t TritSetDecoder::feed(const uint8_t* data, size_t size) {
+    size_t consumed = 0;
+    
+    if (received < sizeof(headerBytes)) {
+        size_t part = sizeof(headerBytes) - received;
+        if (part > size)
+            part = size;
+        
+        std::memcpy(headerBytes + received, data, part);
+        received += part;
+        consumed += part;
+        
+        if (received < sizeof(headerBytes))
+            return consumed;
+        
+        header = tritFileHeaderDecode(headerBytes);
+        if (!tritFileHeaderValid(header, SIZE_MAX))
+            throw std::runtime_error("corrupted trit set header");
+    }
+    
+    // Память выделяется по мере поступления данных, а не по заголовку
+    size_t payload = header.wordsCount * sizeof(uint);
+    size_t offset = received - sizeof(header);
+    size_t part = payload - offset;
+    if (part > size - consumed)
+        part = size - consumed;
+    
+    words.resize((offset + part + sizeof(uint) - 1) / sizeof(uint));
+    std::memcpy((uint8_t*) words.data() + offset, data + consumed, part);
+    
+    received += part;
+    return consumed + part;
+}
+
+bool TritSetDecoder::complete() const {
+    return received >= sizeof(header)
+        && received - sizeof(header) == header.wordsCount * sizeof(uint);
+}
+
+TritSet TritSetDecoder::finish() {
+    if (!complete())
+        throw std::runtime_error("trit set data is incomplete");
+    
+    TritSet result = tritSetFromPayload(header, std::move(words));
+    
+    received = 0;
+    words.clear();
+    
+    return result;
+}
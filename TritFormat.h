@@ -0,0 +1,194 @@
+//
+//  TritFormat.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritFormat_h
+#define TritFormat_h
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "TritSet.h"
+
+/**
+ * Бинарный формат набора тритов.
+ *
+ * Файл состоит из заголовка TritFileHeader, сразу за которым идут
+ * wordsCount слов хранилища в том же виде, что и в памяти TritSet.
+ * Размер заголовка кратен размеру слова, поэтому данные после него
+ * выровнены и могут быть отображены в память без копирования.
+ *
+ * TritSet::serialize всегда пишет поля заголовка и слова в порядке
+ * little-endian, при чтении слова с другим порядком байт переставляются.
+ * В памяти заголовок хранится в порядке байт платформы и переводится
+ * в байты файла и обратно через tritFileHeaderEncode/Decode.
+ */
+
+/** Сигнатура файла. */
+#define TRIT_FILE_MAGIC "TRIT"
+
+/** Текущая версия формата. */
+#define TRIT_FILE_VERSION 1
+
+/** Порядок байт, в котором записаны слова. */
+enum TritByteOrder : uint8_t {
+    TritLittleEndian = 1,
+    TritBigEndian = 2
+};
+
+struct TritFileHeader {
+    char magic[4];          // TRIT_FILE_MAGIC
+    uint16_t version;       // TRIT_FILE_VERSION
+    uint8_t wordSize;       // sizeof(uint)
+    uint8_t byteOrder;      // TritByteOrder
+    uint64_t tritsCount;    // Размер набора тритов
+    uint64_t wordsCount;    // Кол-во слов данных после заголовка
+    uint64_t checksum;      // Контрольная сумма слов данных
+};
+
+static_assert(sizeof(TritFileHeader) == 32, "TritFileHeader must be packed");
+
+/**
+ * Формат набора наборов тритов (см. TritDataset.h).
+ *
+ * Файл состоит из заголовка TritDatasetHeader, слов всех наборов подряд
+ * и индекса из setsCount записей TritDatasetEntry в конце файла.
+ * В отличие от TritFileHeader, заголовок, индекс и слова записываются
+ * в порядке байт платформы, чтобы отображаться в память без копирования.
+ * Файл с другим порядком байт (поле byteOrder) не открывается.
+ * При добавлении наборов новые слова и индекс пишутся после прежнего
+ * индекса, а заголовок обновляется последним, поэтому до записи заголовка
+ * файл остается прежним корректным набором наборов. Прежние индексы
+ * остаются внутри области слов и ни на что не ссылаются.
+ */
+
+/** Сигнатура файла набора наборов. */
+#define TRIT_DATASET_MAGIC "TRDS"
+
+/** Текущая версия формата набора наборов. */
+#define TRIT_DATASET_VERSION 1
+
+struct TritDatasetHeader {
+    char magic[4];          // TRIT_DATASET_MAGIC
+    uint16_t version;       // TRIT_DATASET_VERSION
+    uint8_t wordSize;       // sizeof(uint)
+    uint8_t byteOrder;      // TritByteOrder
+    uint64_t setsCount;     // Кол-во наборов тритов
+    uint64_t indexOffset;   // Смещение индекса от начала файла в байтах
+    uint64_t reserved;
+};
+
+struct TritDatasetEntry {
+    uint64_t wordOffset;    // Смещение слов набора от конца заголовка в словах
+    uint64_t tritsCount;    // Размер набора тритов
+    uint64_t falseCount;    // Кол-во тритов False
+    uint64_t trueCount;     // Кол-во тритов True
+    uint64_t checksum;      // Контрольная сумма слов набора
+};
+
+static_assert(sizeof(TritDatasetHeader) == 32, "TritDatasetHeader must be packed");
+static_assert(sizeof(TritDatasetEntry) == 40, "TritDatasetEntry must be packed");
+
+/**
+ * Порядок байт текущей платформы.
+ */
+TritByteOrder tritNativeByteOrder();
+
+/**
+ * Контрольная сумма (Fletcher-64) слов данных.
+ * @param words Слова данных.
+ * @param count Кол-во слов.
+ * @return Контрольная сумма.
+ */
+uint64_t tritChecksum(const uint* words, size_t count);
+
+/**
+ * Заполняет заголовок для данного набора тритов.
+ * Контрольная сумма считается по значениям слов, поэтому
+ * не зависит от порядка байт.
+ * @param set Набор тритов.
+ * @return Заголовок.
+ */
+TritFileHeader tritFileHeader(const TritSet& set);
+
+/**
+ * Записывает заголовок в байты файла, все поля в порядке little-endian.
+ * @param header Заголовок.
+ * @param bytes Буфер размером sizeof(TritFileHeader).
+ */
+void tritFileHeaderEncode(const TritFileHeader& header, uint8_t* bytes);
+
+/**
+ * Читает заголовок из байт файла.
+ * @see tritFileHeaderEncode(const TritFileHeader&, uint8_t*)
+ */
+TritFileHeader tritFileHeaderDecode(const uint8_t* bytes);
+
+/**
+ * Проверяет сигнатуру, версию и размеры заголовка.
+ * @param header Заголовок.
+ * @param available Кол-во байт данных, доступных после заголовка.
+ * @return Корректен ли заголовок.
+ */
+bool tritFileHeaderValid(const TritFileHeader& header, size_t available);
+
+/**
+ * Переставляет байты в каждом слове.
+ * @param words Слова.
+ * @param count Кол-во слов.
+ */
+void tritWordsByteSwap(uint* words, size_t count);
+
+/**
+ * Проверяет прочитанные слова и собирает из них набор тритов.
+ * @param header Заголовок.
+ * @param words Слова данных в порядке байт из заголовка.
+ * @return Набор тритов.
+ * @throws std::runtime_error Если контрольная сумма не совпала.
+ */
+TritSet tritSetFromPayload(const TritFileHeader& header, std::vector<uint>&& words);
+
+/**
+ * Потоковое чтение бинарного представления, полученного по частям,
+ * например через TritSet::serialize(uint8_t*, size_t, size_t).
+ */
+class TritSetDecoder {
+public:
+    
+    TritSetDecoder();
+    
+    /**
+     * Принимает очередную часть бинарного представления.
+     * @param data Данные.
+     * @param size Размер данных в байтах.
+     * @return Кол-во принятых байт. Меньше size, если представление закончилось.
+     * @throws std::runtime_error Если заголовок поврежден.
+     */
+    size_t feed(const uint8_t* data, size_t size);
+    
+    /**
+     * Получено ли представление целиком.
+     */
+    bool complete() const;
+    
+    /**
+     * Завершает чтение.
+     * @return Прочитанный набор тритов.
+     * @throws std::runtime_error Если представление получено не целиком
+     * или повреждено.
+     */
+    TritSet finish();
+    
+private:
+    uint8_t headerBytes[sizeof(TritFileHeader)];
+    TritFileHeader header;
+    size_t received; // Кол-во полученных байт, включая заголовок
+    std::vector<uint> words;
+};
+
+#endif /* TritFormat_h */
@@ -0,0 +1,250 @@
+//
+//  TritMatrix.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <stdexcept>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "TritMatrix.h"
+#include "TritWord.h"
+
+/** Кол-во полос блоков, транспонируемых за один проход по столбцам. */
+#define TRANSPOSE_BLOCK 16
+
+/**
+ * Транспонирует блок TRITS_PER_WORD x TRITS_PER_WORD тритов на месте:
+ * трит i слова j меняется местами с тритом j слова i.
+ *
+ * Рекурсивный обмен четвертей: сначала меняются внедиагональные
+ * блоки 8 x 8, затем 4 x 4 внутри каждой четверти и так до 1 x 1.
+ */
+static void transposeTile(uint* tile) {
+    uint mask = tritWordLowMask(TRITS_PER_WORD / 2);
+    
+    for (size_t step = TRITS_PER_WORD / 2; step; step >>= 1, mask ^= mask << (step * 2)) {
+        for (size_t i = 0; i < TRITS_PER_WORD; i = ((i | step) + 1) & ~step) {
+            uint swap = ((tile[i] >> (step * 2)) ^ tile[i | step]) & mask;
+            tile[i] ^= swap << (step * 2);
+            tile[i | step] ^= swap;
+        }
+    }
+}
+
+#ifdef __SSE2__
+/**
+ * Транспонирует четыре соседних блока сразу: дорожка k каждого
+ * вектора - слово блока k.
+ * @see transposeTile(uint*)
+ */
+static void transposeTiles(__m128i* tiles) {
+    uint mask = tritWordLowMask(TRITS_PER_WORD / 2);
+    
+    for (int step = TRITS_PER_WORD / 2; step; step >>= 1, mask ^= mask << (step * 2)) {
+        __m128i lanes = _mm_set1_epi32((int) mask);
+        
+        for (int i = 0; i < (int) TRITS_PER_WORD; i = ((i | step) + 1) & ~step) {
+            __m128i swap = _mm_and_si128(_mm_xor_si128(_mm_srli_epi32(tiles[i], step * 2),
+                                                       tiles[i | step]), lanes);
+            tiles[i] = _mm_xor_si128(tiles[i], _mm_slli_epi32(swap, step * 2));
+            tiles[i | step] = _mm_xor_si128(tiles[i | step], swap);
+        }
+    }
+}
+#endif
+
+/**
+ * Транспонирует полосы блоков [first, last) из одной раскладки в другую.
+ * @param source Раскладка-источник: полоса - TRITS_PER_WORD строк по sourceWords слов.
+ * @param sourceWords Слов в строке источника.
+ * @param destination Раскладка-приемник, строка - destinationWords слов.
+ * @param destinationWords Слов в строке приемника.
+ */
+static void transposeBands(const uint* source, size_t sourceWords,
+                           uint* destination, size_t destinationWords, size_t first, size_t last) {
+    for (size_t blockStart = first; blockStart < last; blockStart += TRANSPOSE_BLOCK) {
+        size_t blockEnd = blockStart + TRANSPOSE_BLOCK < last ? blockStart + TRANSPOSE_BLOCK : last;
+        size_t column = 0;
+        
+#ifdef __SSE2__
+        for (; column + 4 <= sourceWords; column += 4) {
+            for (size_t band = blockStart; band < blockEnd; band++) {
+                const uint* rows = source + band * TRITS_PER_WORD * sourceWords + column;
+                __m128i tiles[TRITS_PER_WORD];
+                alignas(16) uint words[4];
+                
+                for (size_t i = 0; i < TRITS_PER_WORD; i++)
+                    tiles[i] = _mm_loadu_si128((const __m128i*) (rows + i * sourceWords));
+                
+                transposeTiles(tiles);
+                
+                for (size_t i = 0; i < TRITS_PER_WORD; i++) {
+                    _mm_store_si128((__m128i*) words, tiles[i]);
+                    for (size_t k = 0; k < 4; k++)
+                        destination[((column + k) * TRITS_PER_WORD + i) * destinationWords + band] = words[k];
+                }
+            }
+        }
+#endif
+        
+        for (; column < sourceWords; column++) {
+            for (size_t band = blockStart; band < blockEnd; band++) {
+                const uint* rows = source + band * TRITS_PER_WORD * sourceWords + column;
+                uint tile[TRITS_PER_WORD];
+                
+                for (size_t i = 0; i < TRITS_PER_WORD; i++)
+                    tile[i] = rows[i * sourceWords];
+                
+                transposeTile(tile);
+                
+                for (size_t i = 0; i < TRITS_PER_WORD; i++)
+                    destination[(column * TRITS_PER_WORD + i) * destinationWords + band] = tile[i];
+            }
+        }
+    }
+}
+
+/**
+ * Копирует триты среза в строку раскладки длиной count тритов.
+ */
+static void storeLine(uint* line, size_t count, const TritSetView& trits) {
+    size_t words = tritWordsCount(count);
+    
+    for (size_t i = 0; i < words; i++)
+        line[i] = trits.word(i);
+    
+    if (words)
+        line[words - 1] &= tritWordLowMask(count - (words - 1) * TRITS_PER_WORD);
+}
+
+TritMatrix::TritMatrix() : TritMatrix(0, 0) {}
+
+TritMatrix::TritMatrix(size_t rows, size_t columns)
+    : rowsCount(rows), columnsCount(columns),
+      rowWords(tritWordsCount(columns)), columnWords(tritWordsCount(rows)),
+      byRows(columnWords * TRITS_PER_WORD * rowWords),
+      byColumns(rowWords * TRITS_PER_WORD * columnWords) {}
+
+/**
+ * Наибольший из размеров строк.
+ */
+static size_t widestRow(const std::vector<TritSet>& rows) {
+    size_t width = 0;
+    for (const TritSet& row : rows)
+        if (row.size() > width)
+            width = row.size();
+    return width;
+}
+
+TritMatrix::TritMatrix(const std::vector<TritSet>& rows, size_t columns)
+    : TritMatrix(rows.size(), columns == TritSet::npos ? widestRow(rows) : columns) {
+    
+    for (size_t i = 0; i < rowsCount; i++)
+        storeLine(byRows.data() + i * rowWords, columnsCount, TritSetView(rows[i]));
+    
+    transposeRows(0, columnWords);
+}
+
+size_t TritMatrix::rows() const {
+    return rowsCount;
+}
+
+size_t TritMatrix::columns() const {
+    return columnsCount;
+}
+
+Trit TritMatrix::getTrit(size_t row, size_t column) const {
+    if (row >= rowsCount || column >= columnsCount)
+        return Unknown;
+    
+    uint word = byRows[row * rowWords + column / TRITS_PER_WORD];
+    return tritFromCode((word >> (column % TRITS_PER_WORD * 2)) & 0b11);
+}
+
+void TritMatrix::setTrit(size_t row, size_t column, Trit trit) {
+    if (row >= rowsCount || column >= columnsCount)
+        throw std::out_of_range("trit matrix position out of range");
+    
+    uint code = tritCode(trit);
+    
+    uint& inRow = byRows[row * rowWords + column / TRITS_PER_WORD];
+    size_t shift = column % TRITS_PER_WORD * 2;
+    inRow = (inRow & ~((uint) 0b11 << shift)) | (code << shift);
+    
+    uint& inColumn = byColumns[column * columnWords + row / TRITS_PER_WORD];
+    shift = row % TRITS_PER_WORD * 2;
+    inColumn = (inColumn & ~((uint) 0b11 << shift)) | (code << shift);
+}
+
+TritSetView TritMatrix::row(size_t index) const {
+    if (index >= rowsCount)
+        throw std::out_of_range("trit matrix row out of range");
+    return TritSetView(byRows.data() + index * rowWords, columnsCount, 0, columnsCount);
+}
+
+TritSetView TritMatrix::column(size_t index) const {
+    if (index >= columnsCount)
+        throw std::out_of_range("trit matrix column out of range");
+    return TritSetView(byColumns.data() + index * columnWords, rowsCount, 0, rowsCount);
+}
+
+void TritMatrix::setRow(size_t index, const TritSetView& trits) {
+    if (index >= rowsCount)
+        throw std::out_of_range("trit matrix row out of range");
+    
+    storeLine(byRows.data() + index * rowWords, columnsCount, trits);
+    transposeRows(index / TRITS_PER_WORD, index / TRITS_PER_WORD + 1);
+}
+
+void TritMatrix::setColumn(size_t index, const TritSetView& trits) {
+    if (index >= columnsCount)
+        throw std::out_of_range("trit matrix column out of range");
+    
+    storeLine(byColumns.data() + index * columnWords, rowsCount, trits);
+    transposeColumns(index / TRITS_PER_WORD, index / TRITS_PER_WORD + 1);
+}
+
+TritMatrix TritMatrix::transposed() const {
+    TritMatrix result;
+    result.rowsCount = columnsCount;
+    result.columnsCount = rowsCount;
+    result.rowWords = columnWords;
+    result.columnWords = rowWords;
+    result.byRows = byColumns;
+    result.byColumns = byRows;
+    return result;
+}
+
+std::vector<TritSet> TritMatrix::toRows() const {
+    std::vector<TritSet> result;
+    result.reserve(rowsCount);
+    
+    for (size_t i = 0; i < rowsCount; i++)
+        result.push_back(row(i).toTritSet());
+    
+    return result;
+}
+
+std::vector<TritSet> TritMatrix::toColumns() const {
+    std::vector<TritSet> result;
+    result.reserve(columnsCount);
+    
+    for (size_t i = 0; i < columnsCount; i++)
+        result.push_back(column(i).toTritSet());
+    
+    return result;
+}
+
+void TritMatrix::transposeRows(size_t first, size_t last) {
+    transposeBands(byRows.data(), rowWords, byColumns.data(), columnWords, first, last);
+}
+
+void TritMatrix::transposeColumns(size_t first, size_t last) {
+    transposeBands(byColumns.data(), columnWords, byRows.data(), rowWords, first, last);
+}
@@ -0,0 +1,139 @@
+//
+//  TritMatrix.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritMatrix_h
+#define TritMatrix_h
+
+#include <cstddef>
+#include <vector>
+
+#include "TritSet.h"
+#include "TritSetView.h"
+
+/**
+ * Матрица тритов фиксированного размера.
+ *
+ * Хранится одновременно по строкам и по столбцам в формате хранилища
+ * TritSet, поэтому и строка, и столбец доступны как непрерывный срез
+ * TritSetView без копирования. Цена - двойной объем памяти и обновление
+ * обеих раскладок при записи.
+ *
+ * Раскладки переводятся друг в друга транспонированием блоков
+ * 16 x 16 тритов (16 слов), при наличии SSE2 - по четыре блока сразу.
+ * Блоки обходятся полосами, чтобы чтение и запись оставались в кэше.
+ */
+class TritMatrix {
+public:
+    
+    /**
+     * Пустая матрица.
+     */
+    TritMatrix();
+    
+    /**
+     * Матрица из Unknown.
+     * @param rows Кол-во строк.
+     * @param columns Кол-во столбцов.
+     */
+    TritMatrix(size_t rows, size_t columns);
+    
+    /**
+     * Матрица из строк.
+     * @param rows Строки матрицы.
+     * @param columns Кол-во столбцов, по умолчанию наибольший из размеров строк.
+     * Более длинные строки обрезаются.
+     */
+    explicit TritMatrix(const std::vector<TritSet>& rows, size_t columns = TritSet::npos);
+    
+    /**
+     * Кол-во строк.
+     */
+    size_t rows() const;
+    
+    /**
+     * Кол-во столбцов.
+     */
+    size_t columns() const;
+    
+    /**
+     * Получение трита.
+     * @return Трит или Unknown за пределами матрицы.
+     */
+    Trit getTrit(size_t row, size_t column) const;
+    
+    /**
+     * Установка трита.
+     * @throws std::out_of_range Если позиция за пределами матрицы.
+     */
+    void setTrit(size_t row, size_t column, Trit trit);
+    
+    /**
+     * Строка матрицы длиной columns().
+     * Срез действителен до следующего изменения матрицы.
+     * @throws std::out_of_range Если номер больше кол-ва строк.
+     */
+    TritSetView row(size_t index) const;
+    
+    /**
+     * Столбец матрицы длиной rows().
+     * @see row(size_t)
+     */
+    TritSetView column(size_t index) const;
+    
+    /**
+     * Заменяет строку. Триты после columns() отбрасываются,
+     * недостающие становятся Unknown.
+     * @throws std::out_of_range Если номер больше кол-ва строк.
+     */
+    void setRow(size_t index, const TritSetView& trits);
+    
+    /**
+     * Заменяет столбец.
+     * @see setRow(size_t, const TritSetView&)
+     */
+    void setColumn(size_t index, const TritSetView& trits);
+    
+    /**
+     * Транспонированная матрица. Раскладки уже построены,
+     * поэтому это только копирование.
+     */
+    TritMatrix transposed() const;
+    
+    /**
+     * Строки матрицы в виде отдельных наборов тритов.
+     */
+    std::vector<TritSet> toRows() const;
+    
+    /**
+     * Столбцы матрицы в виде отдельных наборов тритов.
+     */
+    std::vector<TritSet> toColumns() const;
+
+private:
+    size_t rowsCount;
+    size_t columnsCount;
+    
+    // Строка занимает rowWords слов, строк с запасом до целого блока
+    size_t rowWords;
+    size_t columnWords;
+    
+    std::vector<uint> byRows;
+    std::vector<uint> byColumns;
+    
+    /**
+     * Перестраивает раскладку по столбцам для полос строк [first, last).
+     */
+    void transposeRows(size_t first, size_t last);
+    
+    /**
+     * Перестраивает раскладку по строкам для полос столбцов [first, last).
+     */
+    void transposeColumns(size_t first, size_t last);
+};
+
+#endif /* TritMatrix_h */
@@ -0,0 +1,185 @@
+//
+//  TritNearestIndex.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+
+#include "TritDistance.h"
+#include "TritNearestIndex.h"
+#include "TritWord.h"
+
+/**
+ * Наибольшее расстояние внутри части, для которого перебираются
+ * соседние слова (для 3 это уже 4480 слов на часть), дальше - полный перебор.
+ */
+#define MAX_CHUNK_DISTANCE 2
+
+/**
+ * Сравнение соседей: ближе, при равенстве - с меньшим номером.
+ */
+static bool closer(const TritNeighbor& left, const TritNeighbor& right) {
+    return left.distance != right.distance ? left.distance < right.distance : left.index < right.index;
+}
+
+/**
+ * Вызывает callback для каждого слова, отличающегося от word ровно
+ * в distance тритах на позициях не меньше from.
+ */
+template <typename Callback>
+static void forEachNeighborWord(uint word, size_t distance, size_t from, Callback& callback) {
+    if (!distance) {
+        callback(word);
+        return;
+    }
+    
+    for (size_t pos = from; pos + distance <= TRITS_PER_WORD; pos++) {
+        uint code = (word >> (pos * 2)) & 0b11;
+        uint cleared = word & ~((uint) 0b11 << (pos * 2));
+        
+        // Два других кода из 00, 01, 10
+        for (uint other = 0; other < 3; other++)
+            if (other != code)
+                forEachNeighborWord(cleared | (other << (pos * 2)), distance - 1, pos + 1, callback);
+    }
+}
+
+struct TritNearestIndex::Search {
+    const TritSet& query;
+    size_t k;       // Кол-во соседей, 0 - поиск в радиусе
+    size_t radius;  // Радиус для поиска в радиусе
+    
+    std::vector<bool> checked;
+    std::vector<TritNeighbor> found;
+    std::priority_queue<TritNeighbor, std::vector<TritNeighbor>, decltype(&closer)> best;
+    
+    Search(const TritSet& query, size_t k, size_t radius, size_t setsCount)
+        : query(query), k(k), radius(radius), checked(setsCount), best(closer) {}
+    
+    void check(size_t index, const TritSet& set) {
+        if (checked[index])
+            return;
+        checked[index] = true;
+        
+        TritNeighbor neighbor = {index, tritDistance(query, set)};
+        
+        if (!k) {
+            if (neighbor.distance <= radius)
+                found.push_back(neighbor);
+        } else if (best.size() < k) {
+            best.push(neighbor);
+        } else if (closer(neighbor, best.top())) {
+            best.pop();
+            best.push(neighbor);
+        }
+    }
+    
+    /**
+     * Результат в порядке возрастания расстояния.
+     */
+    std::vector<TritNeighbor> result() {
+        for (; !best.empty(); best.pop())
+            found.push_back(best.top());
+        
+        std::sort(found.begin(), found.end(), closer);
+        return found;
+    }
+};
+
+TritNearestIndex::TritNearestIndex(const std::vector<TritSet>& sets) : sets(sets) {
+    if (sets.size() > UINT32_MAX)
+        throw std::invalid_argument("too many sets for trit nearest index");
+    
+    size_t chunksCount = 0;
+    for (const TritSet& set : sets)
+        chunksCount = std::max(chunksCount, tritWordsCount(set.size()));
+    
+    chunks.resize(chunksCount);
+    
+    for (size_t chunk = 0; chunk < chunksCount; chunk++) {
+        std::vector<Entry>& entries = chunks[chunk];
+        entries.resize(sets.size());
+        
+        for (size_t i = 0; i < sets.size(); i++) {
+            const std::vector<uint>& words = sets[i].words();
+            entries[i] = {chunk < words.size() ? words[chunk] : 0, (uint32_t) i};
+        }
+        
+        std::sort(entries.begin(), entries.end(), [](const Entry& left, const Entry& right) {
+            return left.word != right.word ? left.word < right.word : left.set < right.set;
+        });
+    }
+}
+
+size_t TritNearestIndex::size() const {
+    return sets.size();
+}
+
+void TritNearestIndex::searchLevel(Search& search, size_t distance) const {
+    const std::vector<uint>& queryWords = search.query.words();
+    
+    for (size_t chunk = 0; chunk < chunks.size(); chunk++) {
+        const std::vector<Entry>& entries = chunks[chunk];
+        
+        auto lookup = [&](uint word) {
+            auto first = std::lower_bound(entries.begin(), entries.end(), word,
+                                          [](const Entry& entry, uint word) {
+                return entry.word < word;
+            });
+            
+            for (; first != entries.end() && first->word == word; ++first)
+                search.check(first->set, sets[first->set]);
+        };
+        
+        forEachNeighborWord(chunk < queryWords.size() ? queryWords[chunk] : 0, distance, 0, lookup);
+    }
+}
+
+void TritNearestIndex::searchAll(Search& search) const {
+    for (size_t i = 0; i < sets.size(); i++)
+        search.check(i, sets[i]);
+}
+
+std::vector<TritNeighbor> TritNearestIndex::radius(const TritSet& query, size_t radius) const {
+    Search search(query, 0, radius, sets.size());
+    
+    // Триты запроса за пределами частей не находятся поиском по частям
+    if (chunks.empty() || tritWordsCount(query.size()) > chunks.size()
+        || radius / chunks.size() > MAX_CHUNK_DISTANCE) {
+        searchAll(search);
+        return search.result();
+    }
+    
+    for (size_t distance = 0; distance <= radius / chunks.size(); distance++)
+        searchLevel(search, distance);
+    
+    return search.result();
+}
+
+std::vector<TritNeighbor> TritNearestIndex::nearest(const TritSet& query, size_t k) const {
+    Search search(query, k, 0, sets.size());
+    
+    if (!k)
+        return search.result();
+    
+    if (chunks.empty() || tritWordsCount(query.size()) > chunks.size()) {
+        searchAll(search);
+        return search.result();
+    }
+    
+    for (size_t distance = 0; distance <= MAX_CHUNK_DISTANCE; distance++) {
+        searchLevel(search, distance);
+        
+        // Найдены все наборы на расстоянии до m * (distance + 1) - 1
+        if (search.best.size() == k && search.best.top().distance < chunks.size() * (distance + 1))
+            return search.result();
+    }
+    
+    searchAll(search);
+    return search.result();
+}
@@ -0,0 +1,99 @@
+//
+//  TritNearestIndex.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritNearestIndex_h
+#define TritNearestIndex_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TritSet.h"
+
+/**
+ * Найденный сосед: номер набора и расстояние до него.
+ */
+struct TritNeighbor {
+    size_t index;
+    size_t distance;
+};
+
+/**
+ * Индекс ближайших соседей над наборами тритов по расстоянию
+ * tritDistance (кол-во различающихся позиций).
+ *
+ * Мультииндексное хеширование: наборы разбиты на m частей по слову
+ * хранилища (16 тритов), для каждой части хранится отсортированная
+ * таблица (слово, номер набора). Если расстояние между наборами не больше
+ * m * (s + 1) - 1, то хотя бы одна часть отличается не больше чем
+ * в s тритах, поэтому кандидаты ищутся перебором слов на расстоянии
+ * до s от частей запроса, а затем проверяются полным расстоянием.
+ * При больших радиусах поиск переходит на полный перебор.
+ *
+ * Не владеет наборами: они не должны изменяться или уничтожаться,
+ * пока используется индекс.
+ */
+class TritNearestIndex {
+public:
+    
+    /**
+     * Строит индекс над наборами.
+     * @param sets Наборы тритов, номер набора - его индекс в массиве.
+     * @throws std::invalid_argument Если наборов больше UINT32_MAX.
+     */
+    explicit TritNearestIndex(const std::vector<TritSet>& sets);
+    
+    /**
+     * Кол-во наборов в индексе.
+     */
+    size_t size() const;
+    
+    /**
+     * Все наборы на расстоянии не больше radius от запроса.
+     * @param query Запрос.
+     * @param radius Наибольшее расстояние.
+     * @return Соседи в порядке возрастания расстояния, при равенстве - номера.
+     */
+    std::vector<TritNeighbor> radius(const TritSet& query, size_t radius) const;
+    
+    /**
+     * k ближайших наборов к запросу.
+     * @param query Запрос.
+     * @param k Кол-во соседей.
+     * @return Не больше k соседей в порядке возрастания расстояния, при равенстве - номера.
+     */
+    std::vector<TritNeighbor> nearest(const TritSet& query, size_t k) const;
+
+private:
+    
+    struct Entry {
+        uint word;
+        uint32_t set; // 32 бита, чтобы запись занимала 8 байт
+    };
+    
+    /**
+     * Состояние одного поиска.
+     */
+    struct Search;
+    
+    const std::vector<TritSet>& sets;
+    std::vector<std::vector<Entry>> chunks;
+    
+    /**
+     * Проверяет все наборы, у которых хотя бы одна часть
+     * отличается от запроса ровно в distance тритах.
+     */
+    void searchLevel(Search& search, size_t distance) const;
+    
+    /**
+     * Проверяет все еще не проверенные наборы.
+     */
+    void searchAll(Search& search) const;
+};
+
+#endif /* TritNearestIndex_h */
@@ -0,0 +1,111 @@
+//
+//  TritPositionIndex.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include "TritPositionIndex.h"
+#include "TritWord.h"
+
+TritPositionIndex::TritPositionIndex(const std::vector<TritSet>& sets)
+    : setsCount(sets.size()), tritsCount(0), bitmapWords((sets.size() + 63) / 64) {
+    
+    for (const TritSet& set : sets)
+        if (set.size() > tritsCount)
+            tritsCount = set.size();
+    
+    falses.resize(tritsCount * bitmapWords);
+    trues.resize(tritsCount * bitmapWords);
+    
+    // Транспонирование: обходим только известные триты каждого слова
+    for (size_t i = 0; i < sets.size(); i++) {
+        const uint* words = sets[i].words().data();
+        size_t wordsCount = tritWordsCount(sets[i].size());
+        uint64_t bit = (uint64_t) 1 << (i % 64);
+        size_t offset = i / 64;
+        
+        for (size_t w = 0; w < wordsCount; w++) {
+            for (uint mask = tritWordMatch(words[w], False); mask; mask &= mask - 1)
+                falses[(w * TRITS_PER_WORD + wordLowestBit(mask) / 2) * bitmapWords + offset] |= bit;
+            for (uint mask = tritWordMatch(words[w], True); mask; mask &= mask - 1)
+                trues[(w * TRITS_PER_WORD + wordLowestBit(mask) / 2) * bitmapWords + offset] |= bit;
+        }
+    }
+}
+
+size_t TritPositionIndex::size() const {
+    return setsCount;
+}
+
+size_t TritPositionIndex::positions() const {
+    return tritsCount;
+}
+
+template <typename Operation>
+void TritPositionIndex::apply(Bitmap& bitmap, const TritCondition& condition, Operation operation) const {
+    // За пределами всех наборов триты Unknown: карт для этих позиций нет
+    const uint64_t* falseBits = nullptr;
+    const uint64_t* trueBits = nullptr;
+    if (condition.pos < tritsCount) {
+        falseBits = falses.data() + condition.pos * bitmapWords;
+        trueBits = trues.data() + condition.pos * bitmapWords;
+    }
+    
+    uint64_t invert = condition.negate ? ~(uint64_t) 0 : 0;
+    
+    for (size_t i = 0; i < bitmapWords; i++) {
+        uint64_t falseWord = falseBits ? falseBits[i] : 0;
+        uint64_t trueWord = trueBits ? trueBits[i] : 0;
+        
+        uint64_t match = condition.trit == False ? falseWord
+            : (condition.trit == True ? trueWord : ~(falseWord | trueWord));
+        bitmap[i] = operation(bitmap[i], match ^ invert);
+    }
+    
+    // Биты после последнего набора всегда сброшены
+    if (setsCount % 64)
+        bitmap.back() &= ((uint64_t) 1 << (setsCount % 64)) - 1;
+}
+
+TritPositionIndex::Bitmap TritPositionIndex::match(const TritCondition& condition) const {
+    return matchAll({condition});
+}
+
+TritPositionIndex::Bitmap TritPositionIndex::matchAll(const std::vector<TritCondition>& conditions) const {
+    Bitmap bitmap(bitmapWords, ~(uint64_t) 0);
+    if (setsCount % 64)
+        bitmap.back() = ((uint64_t) 1 << (setsCount % 64)) - 1;
+    
+    for (const TritCondition& condition : conditions)
+        apply(bitmap, condition, [](uint64_t left, uint64_t right) { return left & right; });
+    
+    return bitmap;
+}
+
+TritPositionIndex::Bitmap TritPositionIndex::matchAny(const std::vector<TritCondition>& conditions) const {
+    Bitmap bitmap(bitmapWords);
+    
+    for (const TritCondition& condition : conditions)
+        apply(bitmap, condition, [](uint64_t left, uint64_t right) { return left | right; });
+    
+    return bitmap;
+}
+
+std::vector<size_t> TritPositionIndex::indices(const Bitmap& bitmap) {
+    std::vector<size_t> result;
+    
+    for (size_t i = 0; i < bitmap.size(); i++)
+        for (uint64_t word = bitmap[i]; word; word &= word - 1)
+            result.push_back(i * 64 + wordLowestBit64(word));
+    
+    return result;
+}
+
+size_t TritPositionIndex::count(const Bitmap& bitmap) {
+    size_t result = 0;
+    for (uint64_t word : bitmap)
+        result += wordPopcount64(word);
+    return result;
+}
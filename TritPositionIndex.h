@@ -0,0 +1,99 @@
+//
+//  TritPositionIndex.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritPositionIndex_h
+#define TritPositionIndex_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TritSet.h"
+
+/**
+ * Условие на трит набора: trit на позиции pos (или не trit, если negate).
+ */
+struct TritCondition {
+    size_t pos;
+    Trit trit;
+    bool negate;
+};
+
+/**
+ * Инвертированный индекс позиций над множеством наборов тритов.
+ *
+ * Для каждой позиции хранятся две битовые карты по наборам: у каких наборов
+ * на этой позиции False и у каких True (карта Unknown вычисляется из них).
+ * Условия запроса объединяются пословно, по 64 набора за операцию.
+ *
+ * Индекс копирует данные и не зависит от исходных наборов.
+ */
+class TritPositionIndex {
+public:
+    
+    /** Битовая карта наборов: бит i - набор с номером i. */
+    typedef std::vector<uint64_t> Bitmap;
+    
+    /**
+     * Строит индекс.
+     * @param sets Наборы тритов, номер набора - его индекс в массиве.
+     * Триты за пределами набора считаются Unknown.
+     */
+    explicit TritPositionIndex(const std::vector<TritSet>& sets);
+    
+    /**
+     * Кол-во наборов.
+     */
+    size_t size() const;
+    
+    /**
+     * Кол-во позиций: наибольший из размеров наборов.
+     */
+    size_t positions() const;
+    
+    /**
+     * Наборы, удовлетворяющие условию.
+     */
+    Bitmap match(const TritCondition& condition) const;
+    
+    /**
+     * Наборы, удовлетворяющие всем условиям. Без условий - все наборы.
+     */
+    Bitmap matchAll(const std::vector<TritCondition>& conditions) const;
+    
+    /**
+     * Наборы, удовлетворяющие хотя бы одному условию.
+     */
+    Bitmap matchAny(const std::vector<TritCondition>& conditions) const;
+    
+    /**
+     * Номера наборов битовой карты по возрастанию.
+     */
+    static std::vector<size_t> indices(const Bitmap& bitmap);
+    
+    /**
+     * Кол-во наборов в битовой карте.
+     */
+    static size_t count(const Bitmap& bitmap);
+
+private:
+    size_t setsCount;
+    size_t tritsCount;
+    size_t bitmapWords;
+    
+    std::vector<uint64_t> falses;
+    std::vector<uint64_t> trues;
+    
+    /**
+     * Применяет условие к битовой карте пословной операцией.
+     */
+    template <typename Operation>
+    void apply(Bitmap& bitmap, const TritCondition& condition, Operation operation) const;
+};
+
+#endif /* TritPositionIndex_h */
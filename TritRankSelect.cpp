@@ -0,0 +1,140 @@
+//
+//  TritRankSelect.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include "TritRankSelect.h"
+#include "TritWord.h"
+
+/** Кол-во слов в блоке. */
+#define BLOCK_WORDS 32
+
+/** Кол-во блоков в суперблоке. */
+#define SUPER_BLOCKS 128
+
+#define BLOCK_TRITS (BLOCK_WORDS * TRITS_PER_WORD)
+
+TritRankSelect::TritRankSelect(const TritSet& set)
+    : TritRankSelect(set.words().data(), set.size()) {}
+
+TritRankSelect::TritRankSelect(const MappedTritSet& set)
+    : TritRankSelect(set.words(), set.size()) {}
+
+TritRankSelect::TritRankSelect(const uint* words, size_t tritsCount)
+    : words(words), tritsCount(tritsCount), wordsCount(tritWordsCount(tritsCount)) {
+    
+    // Последний блок начинается не дальше конца данных и нужен для rank(size())
+    size_t blocksCount = wordsCount / BLOCK_WORDS + 1;
+    blocks.resize(blocksCount);
+    superBlocks.resize((blocksCount - 1) / SUPER_BLOCKS + 1);
+    
+    uint64_t falseCount = 0, trueCount = 0;
+    uint16_t blockFalse = 0, blockTrue = 0;
+    
+    for (size_t block = 0; block < blocksCount; block++) {
+        if (block % SUPER_BLOCKS == 0) {
+            superBlocks[block / SUPER_BLOCKS] = {falseCount, trueCount};
+            blockFalse = blockTrue = 0;
+        }
+        
+        blocks[block] = {blockFalse, blockTrue};
+        
+        size_t end = (block + 1) * BLOCK_WORDS < wordsCount ? (block + 1) * BLOCK_WORDS : wordsCount;
+        for (size_t i = block * BLOCK_WORDS; i < end; i++) {
+            size_t falses = wordPopcount(tritWordMatch(words[i], False));
+            size_t trues = wordPopcount(tritWordMatch(words[i], True));
+            falseCount += falses;
+            trueCount += trues;
+            blockFalse += falses;
+            blockTrue += trues;
+        }
+    }
+}
+
+size_t TritRankSelect::size() const {
+    return tritsCount;
+}
+
+size_t TritRankSelect::rank(Trit trit, size_t pos) const {
+    if (pos > tritsCount)
+        pos = tritsCount;
+    
+    if (trit == Unknown)
+        return pos - rank(False, pos) - rank(True, pos);
+    
+    size_t word = pos / TRITS_PER_WORD;
+    size_t block = word / BLOCK_WORDS;
+    size_t count = countBefore(trit, block);
+    
+    for (size_t i = block * BLOCK_WORDS; i < word; i++)
+        count += wordPopcount(tritWordMatch(words[i], trit));
+    
+    size_t tail = pos % TRITS_PER_WORD;
+    if (tail)
+        count += wordPopcount(tritWordMatch(words[word], trit) & (((uint) 1 << (tail * 2)) - 1));
+    
+    return count;
+}
+
+size_t TritRankSelect::select(Trit trit, size_t k) const {
+    if (k >= rank(trit, tritsCount))
+        return TritSet::npos;
+    
+    // Последний суперблок, перед которым не больше k тритов
+    size_t low = 0, high = superBlocks.size();
+    while (high - low > 1) {
+        size_t middle = (low + high) / 2;
+        if (countBefore(trit, middle * SUPER_BLOCKS) <= k)
+            low = middle;
+        else
+            high = middle;
+    }
+    
+    // Последний блок в нем, перед которым не больше k тритов
+    high = (low + 1) * SUPER_BLOCKS < blocks.size() ? (low + 1) * SUPER_BLOCKS : blocks.size();
+    low *= SUPER_BLOCKS;
+    while (high - low > 1) {
+        size_t middle = (low + high) / 2;
+        if (countBefore(trit, middle) <= k)
+            low = middle;
+        else
+            high = middle;
+    }
+    
+    k -= countBefore(trit, low);
+    
+    for (size_t i = low * BLOCK_WORDS; i < wordsCount; i++) {
+        uint mask = tritWordMatch(words[i], trit);
+        size_t count = wordPopcount(mask);
+        
+        if (k < count) {
+            for (; k; k--)
+                mask &= mask - 1;
+            return i * TRITS_PER_WORD + wordLowestBit(mask) / 2;
+        }
+        
+        k -= count;
+    }
+    
+    return TritSet::npos;
+}
+
+size_t TritRankSelect::indexSize() const {
+    return superBlocks.size() * sizeof(SuperBlock) + blocks.size() * sizeof(Block);
+}
+
+size_t TritRankSelect::countBefore(Trit trit, size_t block) const {
+    const SuperBlock& super = superBlocks[block / SUPER_BLOCKS];
+    
+    switch (trit) {
+        case False:
+            return super.falseCount + blocks[block].falseCount;
+        case True:
+            return super.trueCount + blocks[block].trueCount;
+        default:
+            return block * BLOCK_TRITS - countBefore(False, block) - countBefore(True, block);
+    }
+}
@@ -0,0 +1,102 @@
+//
+//  TritRankSelect.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritRankSelect_h
+#define TritRankSelect_h
+
+#include <cstdint>
+#include <vector>
+
+#include "MappedTritSet.h"
+#include "TritSet.h"
+
+/**
+ * Индекс rank/select над неизменяемым набором тритов.
+ *
+ * Хранит кол-во тритов False и True перед каждым суперблоком
+ * (65536 тритов) и перед каждым блоком (512 тритов) внутри суперблока,
+ * что занимает около 3% от размера самого набора. Кол-во Unknown
+ * вычисляется как разность с позицией.
+ *
+ * Не владеет данными: набор тритов не должен изменяться или
+ * уничтожаться, пока используется индекс.
+ */
+class TritRankSelect {
+public:
+    
+    /**
+     * Строит индекс над набором тритов.
+     * @param set Набор тритов.
+     */
+    explicit TritRankSelect(const TritSet& set);
+    
+    /**
+     * Строит индекс над отображенным набором тритов.
+     * @param set Набор тритов.
+     */
+    explicit TritRankSelect(const MappedTritSet& set);
+    
+    /**
+     * Строит индекс над словами хранилища.
+     * @param words Слова в формате хранилища TritSet.
+     * @param tritsCount Размер набора тритов.
+     */
+    TritRankSelect(const uint* words, size_t tritsCount);
+    
+    /**
+     * Размер набора тритов.
+     */
+    size_t size() const;
+    
+    /**
+     * Подсчитывает кол-во тритов данного значения перед позицией за O(1).
+     * @param trit Значение трита.
+     * @param pos Позиция, не включается. Ограничивается размером набора.
+     * @return Кол-во тритов на позициях [0, pos).
+     */
+    size_t rank(Trit trit, size_t pos) const;
+    
+    /**
+     * Ищет позицию трита данного значения с заданным номером за O(log n).
+     * @param trit Значение трита.
+     * @param k Номер трита среди тритов этого значения, начиная с 0.
+     * @return Позиция трита или TritSet::npos, если тритов меньше k + 1.
+     */
+    size_t select(Trit trit, size_t k) const;
+    
+    /**
+     * Размер самого индекса в байтах.
+     */
+    size_t indexSize() const;
+
+private:
+    
+    struct SuperBlock {
+        uint64_t falseCount;
+        uint64_t trueCount;
+    };
+    
+    struct Block {
+        uint16_t falseCount;
+        uint16_t trueCount;
+    };
+    
+    const uint* words;
+    size_t tritsCount;
+    size_t wordsCount;
+    
+    std::vector<SuperBlock> superBlocks;
+    std::vector<Block> blocks;
+    
+    /**
+     * Кол-во тритов данного значения перед блоком.
+     */
+    size_t countBefore(Trit trit, size_t block) const;
+};
+
+#endif /* TritRankSelect_h */
@@ -0,0 +1,308 @@
+//
+//  TritReduce.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+
+#include "TritReduce.h"
+#include "TritWord.h"
+
+/**
+ * Свертка наборов пословной операцией.
+ * @param saturated Слово, после которого результат операции не меняется.
+ */
+template <typename Operation>
+static TritSet reduceSets(const TritSet* const* sets, size_t count,
+                          Operation operation, uint saturated) {
+    if (!count)
+        return TritSet();
+    
+    std::vector<size_t> wordsCounts(count);
+    size_t resultCount = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        wordsCounts[i] = tritWordsCount(sets[i]->size());
+        if (wordsCounts[i] > resultCount)
+            resultCount = wordsCounts[i];
+    }
+    
+    std::vector<uint> result(resultCount);
+    
+    for (size_t begin = 0; begin < resultCount; begin += TRIT_REDUCE_BLOCK) {
+        size_t end = begin + TRIT_REDUCE_BLOCK < resultCount ? begin + TRIT_REDUCE_BLOCK : resultCount;
+        uint* block = result.data() + begin;
+        
+        // Слова за концом набора - Unknown, то есть нули
+        const uint* first = sets[0]->words().data();
+        for (size_t i = begin; i < end; i++)
+            block[i - begin] = i < wordsCounts[0] ? first[i] : 0;
+        
+        for (size_t set = 1; set < count; set++) {
+            const uint* words = sets[set]->words().data();
+            size_t available = wordsCounts[set] > begin ? wordsCounts[set] - begin : 0;
+            size_t size = end - begin;
+            bool full = true;
+            
+            for (size_t i = 0; i < size; i++) {
+                block[i] = operation(block[i], i < available ? words[begin + i] : 0);
+                full &= block[i] == saturated;
+            }
+            
+            if (full)
+                break;
+        }
+    }
+    
+    return TritSet::fromWords(std::move(result));
+}
+
+TritSet reduceAnd(const TritSet* const* sets, size_t count) {
+    return reduceSets(sets, count, tritWordAnd, FALSE_PLANE);
+}
+
+TritSet reduceAnd(const std::vector<const TritSet*>& sets) {
+    return reduceAnd(sets.data(), sets.size());
+}
+
+TritSet reduceOr(const TritSet* const* sets, size_t count) {
+    return reduceSets(sets, count, tritWordOr, TRUE_PLANE);
+}
+
+TritSet reduceOr(const std::vector<const TritSet*>& sets) {
+    return reduceOr(sets.data(), sets.size());
+}
+
+/** Кол-во слов в блоке побитовых счетчиков. */
+#define COUNTER_BLOCK 256
+
+/**
+ * Побитовые счетчики блока слов: plane(j)[i] - j-е биты счетчиков
+ * тритов i-го слова блока. Четные биты считают False, нечетные - True.
+ */
+class CounterPlanes {
+public:
+    
+    CounterPlanes(size_t setsCount) : count(4) {
+        // Не меньше 4 разрядов: Harley-Seal добавляет сразу по 8
+        while (((size_t) 1 << count) <= setsCount)
+            count++;
+        planes.resize(count * COUNTER_BLOCK);
+    }
+    
+    size_t planesCount() const {
+        return count;
+    }
+    
+    uint* plane(size_t index) {
+        return planes.data() + index * COUNTER_BLOCK;
+    }
+    
+    /**
+     * Складывает блок слов с начала begin всех наборов.
+     */
+    void add(const TritSet* const* sets, const size_t* wordsCounts, size_t setsCount,
+             size_t begin, size_t size) {
+        std::fill(planes.begin(), planes.end(), 0);
+        
+        uint ones[COUNTER_BLOCK] = {}, twos[COUNTER_BLOCK] = {}, fours[COUNTER_BLOCK] = {};
+        size_t set = 0;
+        
+        for (; set + 8 <= setsCount; set += 8) {
+            const uint* words[8];
+            size_t available[8];
+            for (size_t k = 0; k < 8; k++) {
+                words[k] = sets[set + k]->words().data() + begin;
+                available[k] = wordsCounts[set + k] > begin ? wordsCounts[set + k] - begin : 0;
+            }
+            
+            for (size_t i = 0; i < size; i++) {
+                uint input[8];
+                for (size_t k = 0; k < 8; k++)
+                    input[k] = i < available[k] ? words[k][i] : 0;
+                
+                uint twosA, twosB, foursA, foursB, eights;
+                carrySave(twosA, ones[i], ones[i], input[0], input[1]);
+                carrySave(twosB, ones[i], ones[i], input[2], input[3]);
+                carrySave(foursA, twos[i], twos[i], twosA, twosB);
+                carrySave(twosA, ones[i], ones[i], input[4], input[5]);
+                carrySave(twosB, ones[i], ones[i], input[6], input[7]);
+                carrySave(foursB, twos[i], twos[i], twosA, twosB);
+                carrySave(eights, fours[i], fours[i], foursA, foursB);
+                
+                addBits(3, i, eights);
+            }
+        }
+        
+        for (; set < setsCount; set++) {
+            const uint* words = sets[set]->words().data() + begin;
+            size_t available = wordsCounts[set] > begin ? wordsCounts[set] - begin : 0;
+            
+            for (size_t i = 0; i < size && i < available; i++)
+                addBits(0, i, words[i]);
+        }
+        
+        for (size_t i = 0; i < size; i++) {
+            addBits(0, i, ones[i]);
+            addBits(1, i, twos[i]);
+            addBits(2, i, fours[i]);
+        }
+    }
+    
+    /**
+     * Маска счетчиков слова, не меньших threshold.
+     */
+    uint atLeast(size_t i, size_t threshold) {
+        uint greater = 0, equal = ~(uint) 0;
+        
+        // Сравнение от старшего разряда к младшему
+        for (size_t j = count; j > 0; j--) {
+            uint bits = plane(j - 1)[i];
+            
+            if ((threshold >> (j - 1)) & 1) {
+                equal &= bits;
+            } else {
+                greater |= equal & bits;
+                equal &= ~bits;
+            }
+        }
+        
+        return threshold >> count ? 0 : greater | equal;
+    }
+
+private:
+    size_t count;
+    std::vector<uint> planes;
+    
+    /**
+     * Сумматор с сохранением переноса: a + b + c = 2 * high + low.
+     */
+    static void carrySave(uint& high, uint& low, uint a, uint b, uint c) {
+        uint u = a ^ b;
+        high = (a & b) | (u & c);
+        low = u ^ c;
+    }
+    
+    /**
+     * Прибавляет биты с весом 2^weight к счетчикам i-го слова.
+     */
+    void addBits(size_t weight, size_t i, uint bits) {
+        for (size_t j = weight; bits && j < count; j++) {
+            uint carry = plane(j)[i] & bits;
+            plane(j)[i] ^= bits;
+            bits = carry;
+        }
+    }
+};
+
+/**
+ * Кол-во слов каждого набора и наибольшее из них.
+ */
+static size_t setsWordsCounts(const TritSet* const* sets, size_t count, std::vector<size_t>& wordsCounts) {
+    size_t result = 0;
+    wordsCounts.resize(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        wordsCounts[i] = tritWordsCount(sets[i]->size());
+        if (wordsCounts[i] > result)
+            result = wordsCounts[i];
+    }
+    
+    return result;
+}
+
+size_t TritCounts::size() const {
+    return falses.size();
+}
+
+size_t TritCounts::setsCount() const {
+    return sets;
+}
+
+size_t TritCounts::count(size_t pos, Trit trit) const {
+    if (pos >= falses.size())
+        return trit == Unknown ? sets : 0;
+    
+    switch (trit) {
+        case False:
+            return falses[pos];
+        case True:
+            return trues[pos];
+        default:
+            return sets - falses[pos] - trues[pos];
+    }
+}
+
+TritCounts countTrits(const TritSet* const* sets, size_t count) {
+    TritCounts result;
+    result.sets = count;
+    
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++)
+        if (sets[i]->size() > size)
+            size = sets[i]->size();
+    
+    result.falses.resize(size);
+    result.trues.resize(size);
+    
+    std::vector<size_t> wordsCounts;
+    size_t resultCount = setsWordsCounts(sets, count, wordsCounts);
+    CounterPlanes planes(count);
+    
+    for (size_t begin = 0; begin < resultCount; begin += COUNTER_BLOCK) {
+        size_t blockSize = begin + COUNTER_BLOCK < resultCount ? COUNTER_BLOCK : resultCount - begin;
+        planes.add(sets, wordsCounts.data(), count, begin, blockSize);
+        
+        // Распаковка счетчиков по позициям
+        for (size_t i = 0; i < blockSize; i++) {
+            size_t first = (begin + i) * TRITS_PER_WORD;
+            size_t last = first + TRITS_PER_WORD < size ? first + TRITS_PER_WORD : size;
+            
+            for (size_t j = 0; j < planes.planesCount(); j++) {
+                uint bits = planes.plane(j)[i];
+                for (size_t pos = first; bits && pos < last; pos++, bits >>= 2) {
+                    result.falses[pos] |= (bits & 1) << j;
+                    result.trues[pos] |= ((bits >> 1) & 1) << j;
+                }
+            }
+        }
+    }
+    
+    return result;
+}
+
+TritCounts countTrits(const std::vector<const TritSet*>& sets) {
+    return countTrits(sets.data(), sets.size());
+}
+
+TritSet tritThreshold(const TritSet* const* sets, size_t count, size_t threshold) {
+    std::vector<size_t> wordsCounts;
+    size_t resultCount = setsWordsCounts(sets, count, wordsCounts);
+    std::vector<uint> result(resultCount);
+    CounterPlanes planes(count);
+    
+    for (size_t begin = 0; begin < resultCount; begin += COUNTER_BLOCK) {
+        size_t blockSize = begin + COUNTER_BLOCK < resultCount ? COUNTER_BLOCK : resultCount - begin;
+        planes.add(sets, wordsCounts.data(), count, begin, blockSize);
+        
+        for (size_t i = 0; i < blockSize; i++) {
+            // Биты False и True совпадают с кодами тритов хранилища
+            uint word = planes.atLeast(i, threshold);
+            uint both = word & (word >> 1) & FALSE_PLANE;
+            result[begin + i] = word & ~(both | (both << 1));
+        }
+    }
+    
+    return TritSet::fromWords(std::move(result));
+}
+
+TritSet majority(const TritSet* const* sets, size_t count) {
+    return tritThreshold(sets, count, count / 2 + 1);
+}
+
+TritSet majority(const std::vector<const TritSet*>& sets) {
+    return majority(sets.data(), sets.size());
+}
@@ -0,0 +1,127 @@
+//
+//  TritReduce.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritReduce_h
+#define TritReduce_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TritSet.h"
+
+/**
+ * Свертка многих наборов тритов за один проход.
+ *
+ * Наборы обходятся блоками по TRIT_REDUCE_BLOCK слов: аккумулятор блока
+ * остается в кэше L1, пока к нему применяются все наборы, и промежуточные
+ * наборы не создаются. Результат совпадает с цепочкой операторов
+ * sets[0] & sets[1] & ... (более короткие наборы дополняются Unknown).
+ */
+
+/** Размер блока в словах (16 КБ). */
+#define TRIT_REDUCE_BLOCK 4096
+
+/**
+ * AND всех наборов. Блок, ставший полностью False, дальше не читается.
+ * @param sets Наборы тритов.
+ * @param count Кол-во наборов.
+ * @return Результат или пустой набор, если наборов нет.
+ */
+TritSet reduceAnd(const TritSet* const* sets, size_t count);
+
+/**
+ * @see reduceAnd(const TritSet* const*, size_t)
+ */
+TritSet reduceAnd(const std::vector<const TritSet*>& sets);
+
+/**
+ * OR всех наборов. Блок, ставший полностью True, дальше не читается.
+ * @param sets Наборы тритов.
+ * @param count Кол-во наборов.
+ * @return Результат или пустой набор, если наборов нет.
+ */
+TritSet reduceOr(const TritSet* const* sets, size_t count);
+
+/**
+ * @see reduceOr(const TritSet* const*, size_t)
+ */
+TritSet reduceOr(const std::vector<const TritSet*>& sets);
+
+/**
+ * Кол-во тритов каждого значения на каждой позиции по многим наборам.
+ */
+class TritCounts {
+public:
+    
+    /**
+     * Кол-во позиций: наибольший из размеров наборов.
+     */
+    size_t size() const;
+    
+    /**
+     * Кол-во наборов.
+     */
+    size_t setsCount() const;
+    
+    /**
+     * Кол-во наборов, в которых трит на позиции равен данному значению.
+     * За пределами наборов триты считаются Unknown.
+     */
+    size_t count(size_t pos, Trit trit) const;
+
+private:
+    size_t sets;
+    std::vector<uint32_t> falses;
+    std::vector<uint32_t> trues;
+    
+    friend TritCounts countTrits(const TritSet* const* sets, size_t count);
+};
+
+/**
+ * Подсчитывает значения тритов на каждой позиции по всем наборам.
+ *
+ * Счетчики побитовые: j-й бит счетчиков всех 16 позиций слова (отдельно
+ * для False и True) хранится в одном слове, наборы складываются
+ * сумматорами с сохранением переноса по 8 за раз (схема Harley-Seal).
+ * @param sets Наборы тритов.
+ * @param count Кол-во наборов.
+ * @return Счетчики.
+ */
+TritCounts countTrits(const TritSet* const* sets, size_t count);
+
+/**
+ * @see countTrits(const TritSet* const*, size_t)
+ */
+TritCounts countTrits(const std::vector<const TritSet*>& sets);
+
+/**
+ * Пороговое голосование: трит равен True (False), если True (False)
+ * он не меньше чем в threshold наборах, иначе - Unknown. Если порога
+ * достигают оба значения, результат - Unknown.
+ * Счетчики сравниваются с порогом побитово, не распаковываясь.
+ * @param sets Наборы тритов.
+ * @param count Кол-во наборов.
+ * @param threshold Порог, больше 0.
+ * @return Результат голосования.
+ */
+TritSet tritThreshold(const TritSet* const* sets, size_t count, size_t threshold);
+
+/**
+ * Голосование большинством: значение, которое имеет трит
+ * больше чем в половине наборов, иначе - Unknown.
+ * @see tritThreshold(const TritSet* const*, size_t, size_t)
+ */
+TritSet majority(const TritSet* const* sets, size_t count);
+
+/**
+ * @see majority(const TritSet* const*, size_t)
+ */
+TritSet majority(const std::vector<const TritSet*>& sets);
+
+#endif /* TritReduce_h */
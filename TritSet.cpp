@@ -6,14 +6,22 @@
 //  Copyright © 2017 Кирилл. All rights reserved.
 //
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <stdexcept>
 
 #include "TritSet.h"
+#include "TritFormat.h"
+#include "TritWord.h"
 
 #define FALSE_BIT_MASK 0b01
 #define UNKNOWN_BIT_MASK 0b00
 #define TRUE_BIT_MASK 0b10
 
+const size_t TritSet::npos;
+const size_t TritSet::const_iterator::WORD_TRITS;
+
 TritSet::TritSet(size_t tritsCount, Trit defaultValue) {
     
     lastTritPos = 0;
@@ -29,6 +37,24 @@ size_t TritSet::capacity() const {
     return !storage.size() ? 0 : (storage.size() + 1) * sizeof(uint) * 8 / 2;
 }
 
+TritSet TritSet::fromWords(const uint* words, size_t count) {
+    TritSet result;
+    result.storage.assign(words, words + count);
+    result.countLastTritPos();
+    return result;
+}
+
+TritSet TritSet::fromWords(std::vector<uint>&& words) {
+    TritSet result;
+    result.storage = std::move(words);
+    result.countLastTritPos();
+    return result;
+}
+
+const std::vector<uint>& TritSet::words() const {
+    return storage;
+}
+
 size_t TritSet::size() const {
     return lastTritPos || getTrit(0) != Unknown ? lastTritPos + 1 : 0;
 }
@@ -36,7 +62,7 @@ size_t TritSet::size() const {
 Trit TritSet::getTrit(size_t pos) const {
     size_t uintPos = pos * 2 / 8 / sizeof(uint);
     
-    if (uintPos > storage.size() || !storage.size())
+    if (uintPos >= storage.size())
         return Unknown;
     
     uint data = storage[uintPos];
@@ -51,11 +77,7 @@ Trit TritSet::getTrit(size_t pos) const {
 }
 
 size_t TritSet::cardinality(Trit trit) const {
-    size_t count = 0;
-    for (size_t i = 0; i < size(); i++)
-        if (getTrit(i) == trit)
-            count++;
-    return count;
+    return tritWordsCardinality(storage.data(), size(), trit);
 }
 
 std::unordered_map<Trit, size_t, std::hash<size_t>> TritSet::cardinality() const {
@@ -66,31 +88,50 @@ std::unordered_map<Trit, size_t, std::hash<size_t>> TritSet::cardinality() const
     return map;
 }
 
+size_t TritSet::findFirst(Trit trit) const {
+    size_t pos = tritWordsFindNext(storage.data(), size(), trit, 0);
+    return pos == size() ? npos : pos;
+}
+
+size_t TritSet::findNext(Trit trit, size_t pos) const {
+    if (pos >= size())
+        return npos;
+    pos = tritWordsFindNext(storage.data(), size(), trit, pos + 1);
+    return pos == size() ? npos : pos;
+}
+
+size_t TritSet::findLast(Trit trit) const {
+    size_t pos = tritWordsFindPrev(storage.data(), size(), trit, size());
+    return pos == size() ? npos : pos;
+}
+
+size_t TritSet::findPrev(Trit trit, size_t pos) const {
+    pos = tritWordsFindPrev(storage.data(), size(), trit, pos);
+    return pos == size() ? npos : pos;
+}
+
 TritSet& TritSet::trim(size_t from) {
     
-    // TODO - переписать более оптимизированно
-    // Сначала удалять лишние блоки uint сразу из storage,
-    // а после удалять оставшиеся триты с последенего.
-    // Таким образом не придется вызывать позже shrink и
-    // выполнять операции с кучей лишних тритов.
+    // Сначала удаляем лишние слова целиком,
+    // а после сбрасываем оставшиеся триты последнего слова.
     
-    size_t removeCount = lastTritPos - from;
+    if (from >= storage.size() * TRITS_PER_WORD)
+        return *this;
     
-    for (size_t i = 0; i < removeCount; i++)
-        _setTrit(i + from, Unknown);
+    storage.resize(tritWordsCount(from));
+    
+    size_t tail = from % TRITS_PER_WORD;
+    if (tail)
+        storage.back() &= ((uint) 1 << (tail * 2)) - 1;
     
-    shrink();
     countLastTritPos();
+    shrink();
     
     return *this;
 }
 
 TritSet& TritSet::shrink() {
-    size_t diff = storage.size() - ceil(lastTritPos * 2 / 8. / sizeof(uint));
-    
-    for (size_t i = 0; i < diff; i++)
-        storage.pop_back();
-    
+    storage.resize(tritWordsCount(size()));
     return *this;
 }
 
@@ -98,16 +139,87 @@ TritSet& TritSet::setTrit(size_t pos, Trit value) {
     if (getTrit(pos) == value)
         return *this;
     _setTrit(pos, value);
+    updateLastTritPos(pos, value);
+    return *this;
+}
+
+TritSet& TritSet::copyRange(const TritSet& source, size_t sourcePos, size_t pos, size_t length) {
+    if (&source == this && sourcePos == pos)
+        return *this;
+    
+    // Триты источника, которые не Unknown, лежат в пределах его хранилища
+    size_t available = source.storage.size() * TRITS_PER_WORD;
+    size_t copied = sourcePos < available ? std::min(length, available - sourcePos) : 0;
+    
+    if (copied && storage.size() < tritWordsCount(pos + copied))
+        storage.resize(tritWordsCount(pos + copied));
+    
+    tritWordsCopy(source.storage.data(), sourcePos, storage.data(), pos, copied);
+    
+    size_t stored = storage.size() * TRITS_PER_WORD;
+    if (pos + copied < stored)
+        tritWordsClear(storage.data(), pos + copied, std::min(length - copied, stored - pos - copied));
+    
     countLastTritPos();
     return *this;
 }
 
+TritSet& TritSet::append(const TritSet& set) {
+    return copyRange(set, 0, size(), set.size());
+}
+
+TritSet& TritSet::insert(size_t pos, const TritSet& set) {
+    if (&set == this)
+        return insert(pos, TritSet(set));
+    
+    size_t count = size();
+    if (pos < count) {
+        storage.resize(tritWordsCount(count + set.size()));
+        tritWordsCopy(storage.data(), pos, storage.data(), pos + set.size(), count - pos);
+    }
+    
+    return copyRange(set, 0, pos, set.size());
+}
+
+TritSet& TritSet::operator<<=(size_t count) {
+    size_t tritsCount = size();
+    if (!count || !tritsCount)
+        return *this;
+    
+    storage.resize(tritWordsCount(tritsCount + count));
+    tritWordsCopy(storage.data(), 0, storage.data(), count, tritsCount);
+    tritWordsClear(storage.data(), 0, std::min(count, tritsCount));
+    
+    lastTritPos += count;
+    return *this;
+}
+
+TritSet& TritSet::operator>>=(size_t count) {
+    size_t tritsCount = size();
+    if (!count || !tritsCount)
+        return *this;
+    
+    if (count >= tritsCount) {
+        std::fill(storage.begin(), storage.end(), 0);
+        lastTritPos = 0;
+        return *this;
+    }
+    
+    tritWordsCopy(storage.data(), count, storage.data(), 0, tritsCount - count);
+    tritWordsClear(storage.data(), tritsCount - count, count);
+    
+    lastTritPos -= count;
+    return *this;
+}
+
 bool TritSet::operator==(const TritSet& set) const {
     if (set.size() != size())
         return false;
     
-    for (size_t i = 0; i < size(); i++)
-        if (getTrit(i) != set.getTrit(i))
+    // Триты после последнего установленного - нулевые слова
+    size_t count = tritWordsCount(size());
+    for (size_t i = 0; i < count; i++)
+        if (storage[i] != set.storage[i])
             return false;
     
     return true;
@@ -121,68 +233,178 @@ TritSet::ModifiableTrit TritSet::operator[](size_t pos) const {
     return TritSet::ModifiableTrit(const_cast<TritSet&>(*this), pos);
 }
 
+TritSet::iterator TritSet::begin() {
+    return iterator(this, 0);
+}
+
+TritSet::iterator TritSet::end() {
+    return iterator(this, size());
+}
+
+TritSet::const_iterator TritSet::begin() const {
+    return const_iterator(storage.data(), storage.size(), 0);
+}
+
+TritSet::const_iterator TritSet::end() const {
+    return const_iterator(storage.data(), storage.size(), size());
+}
+
+TritSet::const_iterator TritSet::cbegin() const {
+    return begin();
+}
+
+TritSet::const_iterator TritSet::cend() const {
+    return end();
+}
+
+TritSet::Positions TritSet::positions(Trit trit) const {
+    return Positions(this, trit);
+}
+
 TritSet TritSet::operator~() const {
     TritSet result;
-    for (size_t i = 0; i < size(); i++)
-        result._setTrit(i, ~getTrit(i));
+    result.storage.resize(tritWordsCount(size()));
+    
+    for (size_t i = 0; i < result.storage.size(); i++)
+        result.storage[i] = tritWordNot(storage[i]);
+    
     result.countLastTritPos();
     return result;
 }
 
-TritSet TritSet::operator&(const TritSet& set) const {
-    TritSet result;
+/**
+ * Применяет пословную операцию к двум наборам за один проход.
+ * Более короткий набор дополняется тритами Unknown.
+ */
+template <typename Operation>
+static TritSet zipSets(const TritSet& left, const TritSet& right, Operation operation) {
+    size_t leftCount = tritWordsCount(left.size());
+    size_t rightCount = tritWordsCount(right.size());
+    std::vector<uint> result(leftCount > rightCount ? leftCount : rightCount);
     
-    size_t maxSize = size();
-    if (set.size() > size())
-        maxSize = set.size();
+    tritWordsZip(left.words().data(), leftCount, right.words().data(), rightCount,
+                 result.data(), operation);
     
-    for (size_t i = 0; i < maxSize; i++)
-        if (i <= lastTritPos && i <= set.lastTritPos)
-            result._setTrit(i, getTrit(i) & set.getTrit(i));
-        else if (i <= lastTritPos)
-            result._setTrit(i, getTrit(i) & Unknown);
-        else
-            result._setTrit(i, set.getTrit(i) & Unknown);
+    return TritSet::fromWords(std::move(result));
+}
+
+TritSet TritSet::operator&(const TritSet& set) const {
+    return zipSets(*this, set, tritWordAnd);
+}
+
+TritSet TritSet::operator|(const TritSet& set) const {
+    return zipSets(*this, set, tritWordOr);
+}
+
+TritSet TritSet::operator^(const TritSet& set) const {
+    return zipSets(*this, set, tritWordXor);
+}
+
+TritSet TritSet::implies(const TritSet& set) const {
+    return zipSets(*this, set, tritWordImplies);
+}
+
+TritSet TritSet::equivalent(const TritSet& set) const {
+    return zipSets(*this, set, tritWordEquivalent);
+}
+
+TritSet TritSet::consensus(const TritSet& set) const {
+    return zipSets(*this, set, tritWordConsensus);
+}
+
+std::ostream& TritSet::operator<<(std::ostream& stream) {
+    return stream << *this;
+}
+
+size_t TritSet::serializedSize() const {
+    return sizeof(TritFileHeader) + tritWordsCount(size()) * sizeof(uint);
+}
+
+std::ostream& TritSet::serialize(std::ostream& stream) const {
+    TritFileHeader header = tritFileHeader(*this);
+    uint8_t bytes[sizeof(TritFileHeader)];
+    tritFileHeaderEncode(header, bytes);
+    stream.write((const char*) bytes, sizeof(bytes));
     
-    result.countLastTritPos();
+    if (tritNativeByteOrder() == TritLittleEndian) {
+        stream.write((const char*) storage.data(), header.wordsCount * sizeof(uint));
+        return stream;
+    }
     
-    return result;
+    // Переставляем байты блоками, чтобы не копировать хранилище целиком
+    uint block[1024];
+    for (size_t i = 0; i < header.wordsCount; i += 1024) {
+        size_t count = header.wordsCount - i < 1024 ? header.wordsCount - i : 1024;
+        std::copy(storage.begin() + i, storage.begin() + i + count, block);
+        tritWordsByteSwap(block, count);
+        stream.write((const char*) block, count * sizeof(uint));
+    }
+    
+    return stream;
 }
 
-TritSet TritSet::operator|(const TritSet& set) const {
-    TritSet result;
+size_t TritSet::serialize(uint8_t* buffer, size_t bufferSize, size_t offset) const {
+    size_t total = serializedSize();
+    if (offset >= total)
+        return 0;
+    
+    size_t written = 0;
     
-    size_t maxSize = size();
-    if (set.size() > size())
-        maxSize = set.size();
+    if (offset < sizeof(TritFileHeader)) {
+        uint8_t header[sizeof(TritFileHeader)];
+        tritFileHeaderEncode(tritFileHeader(*this), header);
+        written = sizeof(header) - offset;
+        if (written > bufferSize)
+            written = bufferSize;
+        std::memcpy(buffer, header + offset, written);
+        
+        if (written == bufferSize)
+            return written;
+    }
     
-    for (size_t i = 0; i < maxSize; i++)
-        if (i <= lastTritPos && i <= set.lastTritPos)
-            result._setTrit(i, getTrit(i) | set.getTrit(i));
-        else if (i <= lastTritPos)
-            result._setTrit(i, getTrit(i) | Unknown);
-        else
-            result._setTrit(i, set.getTrit(i) | Unknown);
+    size_t payloadOffset = offset + written - sizeof(TritFileHeader);
+    size_t part = total - (offset + written);
+    if (part > bufferSize - written)
+        part = bufferSize - written;
     
-    result.countLastTritPos();
+    if (tritNativeByteOrder() == TritLittleEndian)
+        std::memcpy(buffer + written, (const uint8_t*) storage.data() + payloadOffset, part);
+    else
+        for (size_t i = 0; i < part; i++) {
+            size_t byte = payloadOffset + i;
+            buffer[written + i] = storage[byte / sizeof(uint)] >> (byte % sizeof(uint) * 8);
+        }
     
-    return result;
+    return written + part;
 }
 
-std::ostream& TritSet::operator<<(std::ostream& stream) {
-    for (size_t i = 0; i < size(); i++) {
-        switch (getTrit(i)) {
-            case False:
-                stream << 'F';
-                break;
-            case Unknown:
-                stream << 'U';
-                break;
-            case True:
-                stream << 'T';
-        }
+TritSet TritSet::deserialize(std::istream& stream) {
+    uint8_t bytes[sizeof(TritFileHeader)];
+    if (!stream.read((char*) bytes, sizeof(bytes)))
+        throw std::runtime_error("corrupted trit set stream");
+    
+    TritFileHeader header = tritFileHeaderDecode(bytes);
+    if (!tritFileHeaderValid(header, SIZE_MAX))
+        throw std::runtime_error("corrupted trit set stream");
+    
+    // Читаем блоками, чтобы не выделять память по непроверенному заголовку
+    const size_t blockWords = 1 << 20;
+    std::vector<uint> words;
+    
+    for (size_t read = 0; read < header.wordsCount; read += blockWords) {
+        size_t count = header.wordsCount - read < blockWords ? header.wordsCount - read : blockWords;
+        words.resize(read + count);
+        if (!stream.read((char*) (words.data() + read), count * sizeof(uint)))
+            throw std::runtime_error("trit set stream is incomplete");
     }
-    return stream;
+    
+    return tritSetFromPayload(header, std::move(words));
+}
+
+TritSet TritSet::deserialize(const uint8_t* buffer, size_t bufferSize) {
+    TritSetDecoder decoder;
+    decoder.feed(buffer, bufferSize);
+    return decoder.finish();
 }
 
 void TritSet::_setTrit(size_t pos, Trit value) {
@@ -200,7 +422,7 @@ void TritSet::_setTrit(size_t pos, Trit value) {
     }
         
     uint data = storage[uintPos];
-    data &= ~(11 << (pos * 2)); // Сбрасываем биты
+    data &= ~((uint) 0b11 << (pos * 2)); // Сбрасываем биты
     
     uint mask;
     switch (value) {
@@ -219,44 +441,17 @@ void TritSet::_setTrit(size_t pos, Trit value) {
     
 }
 
-void TritSet::countLastTritPos() {
-    size_t allowedPos = storage.size() * sizeof(uint) * 8 / 2;
-    
-    for (size_t i = 0; i < allowedPos; i++)
-        if (getTrit(i) != Unknown)
-            lastTritPos = i;
+void TritSet::updateLastTritPos(size_t pos, Trit value) {
+    if (value != Unknown) {
+        if (pos > lastTritPos)
+            lastTritPos = pos;
+    } else if (pos == lastTritPos)
+        countLastTritPos();
 }
 
-Trit operator~(const Trit& trit) {
-    switch (trit) {
-        case False:
-            return True;
-        case Unknown:
-            return Unknown;
-        case True:
-            return False;
-    }
-}
-
-Trit operator&(const Trit& left, const Trit& right) {
-    switch (left) {
-        case False:
-            return False;
-        case Unknown:
-            return right == False ? False : Unknown;
-        case True:
-            return right == False ? False : (right == True ? True : Unknown);
-    }
-}
-
-Trit operator|(const Trit& left, const Trit& right) {
-    switch (left) {
-        case False:
-            return right == True ? True : (right == False ? False : Unknown);
-        case Unknown:
-            return right == True ? True : Unknown;
-        case True:
-            return True;
-    }
+void TritSet::countLastTritPos() {
+    size_t allowedPos = storage.size() * TRITS_PER_WORD;
+    size_t pos = tritWordsLastKnown(storage.data(), storage.size());
+    
+    lastTritPos = pos == allowedPos ? 0 : pos;
 }
-
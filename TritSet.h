@@ -9,7 +9,10 @@
 #ifndef TritSet_h
 #define TritSet_h
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <vector>
 #include <unordered_map>
 
@@ -27,10 +30,30 @@ enum Trit {
     True
 };
 
+/**
+ * Код трита в хранилище: False - 01, Unknown - 00, True - 10.
+ */
+constexpr uint tritCode(Trit trit) {
+    return trit == False ? 0b01 : (trit == True ? 0b10 : 0);
+}
+
+/**
+ * Трит по коду в хранилище, обратная к tritCode функция.
+ */
+constexpr Trit tritFromCode(uint code) {
+    return Trit(code ^ ((code >> 1) ^ 1));
+}
+
 class TritSet {
 public:
     
     class ModifiableTrit;
+    class iterator;
+    class const_iterator;
+    class Positions;
+    
+    /** Результат поиска, если трит не найден. */
+    static const size_t npos = (size_t) -1;
     
     /**
      * @param tritsCount Кол-во тритов, которые нужно изначально выделить.
@@ -61,6 +84,26 @@ public:
      */
     size_t size() const;
     
+    /**
+     * Создает набор тритов из слов хранилища.
+     * @param words Слова в формате внутреннего хранилища.
+     * @param count Кол-во слов.
+     * @return Набор тритов.
+     */
+    static TritSet fromWords(const uint* words, size_t count);
+    
+    /**
+     * @see fromWords(const uint*, size_t)
+     */
+    static TritSet fromWords(std::vector<uint>&& words);
+    
+    /**
+     * Слова внутреннего хранилища. Каждый трит занимает 2 бита,
+     * триты после последнего установленного - нулевые.
+     * @return Хранилище тритов.
+     */
+    const std::vector<uint>& words() const;
+    
     /**
      * Получает значение трита для данной позиции.
      * @param pos Позиция для получения трита.
@@ -85,6 +128,37 @@ public:
      */
     std::unordered_map<Trit, size_t, std::hash<size_t>> cardinality() const;
     
+    /**
+     * Ищет первый трит данного значения.
+     * Поиск ведется пословно, слова без подходящих тритов пропускаются целиком.
+     * @param trit Искомое значение.
+     * @return Позиция трита или npos, если трит не найден до size().
+     */
+    size_t findFirst(Trit trit) const;
+    
+    /**
+     * Ищет следующий трит данного значения.
+     * @param trit Искомое значение.
+     * @param pos Позиция, после которой начинается поиск.
+     * @return Позиция трита или npos, если трит не найден до size().
+     */
+    size_t findNext(Trit trit, size_t pos) const;
+    
+    /**
+     * Ищет последний трит данного значения.
+     * @param trit Искомое значение.
+     * @return Позиция трита или npos, если трит не найден.
+     */
+    size_t findLast(Trit trit) const;
+    
+    /**
+     * Ищет предыдущий трит данного значения.
+     * @param trit Искомое значение.
+     * @param pos Позиция, перед которой заканчивается поиск.
+     * @return Позиция трита или npos, если трит не найден.
+     */
+    size_t findPrev(Trit trit, size_t pos) const;
+    
     /**
      * Удаляет все значения после позиции from и освобождает лишнюю память.
      * @param from Позиция удаления.
@@ -112,6 +186,47 @@ public:
      */
     TritSet& setTrit(size_t pos, Trit value);
     
+    /**
+     * Копирует триты другого набора пословно.
+     * Триты за пределами источника копируются как Unknown.
+     * @param source Набор-источник, может совпадать с этим набором.
+     * @param sourcePos Позиция первого копируемого трита источника.
+     * @param pos Позиция, на которую копируется первый трит.
+     * @param length Кол-во копируемых тритов.
+     * @return Измененный объект(самого себя)
+     */
+    TritSet& copyRange(const TritSet& source, size_t sourcePos, size_t pos, size_t length);
+    
+    /**
+     * Добавляет триты набора после последнего не Unknown трита.
+     * @param set Добавляемый набор, триты [0, set.size()).
+     * @return Измененный объект(самого себя)
+     */
+    TritSet& append(const TritSet& set);
+    
+    /**
+     * Вставляет триты набора на позицию, сдвигая триты
+     * начиная с этой позиции на set.size() вперед.
+     * @param pos Позиция вставки.
+     * @param set Вставляемый набор, триты [0, set.size()).
+     * @return Измененный объект(самого себя)
+     */
+    TritSet& insert(size_t pos, const TritSet& set);
+    
+    /**
+     * Сдвигает триты на count позиций вперед, освободившиеся
+     * позиции в начале заполняются Unknown.
+     * @return Измененный объект(самого себя)
+     */
+    TritSet& operator<<=(size_t count);
+    
+    /**
+     * Сдвигает триты на count позиций назад, первые count тритов теряются.
+     * Выделенная память не освобождается.
+     * @return Измененный объект(самого себя)
+     */
+    TritSet& operator>>=(size_t count);
+    
     /**
      * Оператор сравнения.
      */
@@ -127,6 +242,24 @@ public:
      * */
     ModifiableTrit operator[](size_t pos) const;
     
+    /**
+     * Итераторы по тритам [0, size()).
+     */
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    
+    /**
+     * Позиции всех тритов данного значения по возрастанию.
+     * Перебор пропускает слова без подходящих тритов целиком.
+     * @param trit Значение трита.
+     * @return Диапазон позиций для range-for и алгоритмов.
+     */
+    Positions positions(Trit trit) const;
+    
     /**
      * Логическое NOT.
      */
@@ -142,33 +275,400 @@ public:
      */
     TritSet operator|(const TritSet& set) const;
     
+    /**
+     * Логическое XOR: True, если оба трита известны и различны.
+     */
+    TritSet operator^(const TritSet& set) const;
+    
+    /**
+     * Импликация Клини: ~this | set, за один проход.
+     */
+    TritSet implies(const TritSet& set) const;
+    
+    /**
+     * Эквивалентность Клини: ~(this ^ set), за один проход.
+     */
+    TritSet equivalent(const TritSet& set) const;
+    
+    /**
+     * Консенсус: трит известен, только если в обоих наборах
+     * он известен и совпадает, иначе - Unknown.
+     */
+    TritSet consensus(const TritSet& set) const;
+    
     /**
      * Вывод в поток.
+     * @see operator<<(std::ostream&, const TritSet&)
      */
     std::ostream& operator<<(std::ostream& stream);
     
-    /** Для выражений set[%index%] и set[%index%] = %value% */
+    /**
+     * Размер бинарного представления набора тритов в байтах.
+     * @see serialize(std::ostream&)
+     */
+    size_t serializedSize() const;
+    
+    /**
+     * Записывает набор тритов в бинарном формате (см. TritFormat.h).
+     * Слова хранилища записываются одним вызовом write в порядке
+     * байт little-endian.
+     * @param stream Поток для записи.
+     * @return Поток для записи.
+     */
+    std::ostream& serialize(std::ostream& stream) const;
+    
+    /**
+     * Записывает часть бинарного представления в буфер.
+     * Позволяет передавать большой набор тритов через буфер
+     * ограниченного размера, последовательно увеличивая offset.
+     * @param buffer Буфер для записи.
+     * @param bufferSize Размер буфера в байтах.
+     * @param offset Смещение от начала бинарного представления.
+     * @return Кол-во записанных байт, 0 - если представление закончилось.
+     */
+    size_t serialize(uint8_t* buffer, size_t bufferSize, size_t offset = 0) const;
+    
+    /**
+     * Читает набор тритов в бинарном формате.
+     * Данные читаются блоками прямо в хранилище.
+     * @param stream Поток для чтения.
+     * @return Прочитанный набор тритов.
+     * @throws std::runtime_error Если данные повреждены или поток закончился.
+     */
+    static TritSet deserialize(std::istream& stream);
+    
+    /**
+     * Читает набор тритов в бинарном формате из буфера.
+     * @param buffer Буфер с бинарным представлением.
+     * @param bufferSize Размер буфера в байтах.
+     * @return Прочитанный набор тритов.
+     * @throws std::runtime_error Если данные повреждены или буфер закончился.
+     */
+    static TritSet deserialize(const uint8_t* buffer, size_t bufferSize);
+    
+    /**
+     * Для выражений set[%index%] и set[%index%] = %value%.
+     * Ссылка, полученная из iterator, хранит указатель на слово хранилища
+     * и сдвиг трита в нем и читает и пишет трит прямо в слове.
+     */
     class ModifiableTrit {
     public:
         ModifiableTrit& operator=(Trit trit) {
-            set.setTrit(pos, trit);
+            if (!word) {
+                set.setTrit(pos, trit);
+                return *this;
+            }
+            
+            if ((*word >> shift & 0b11) == tritCode(trit))
+                return *this;
+            
+            *word = (*word & ~((uint) 0b11 << shift)) | tritCode(trit) << shift;
+            set.updateLastTritPos(pos, trit);
             return *this;
         }
         
+        /** Присваивание значения другого трита, как у std::vector<bool>::reference. */
+        ModifiableTrit& operator=(const ModifiableTrit& trit) {
+            return *this = Trit(trit);
+        }
+        
         operator Trit() const {
-            return set.getTrit(pos);
+            if (!word)
+                return set.getTrit(pos);
+            
+            return tritFromCode(*word >> shift & 0b11);
+        }
+        
+        ModifiableTrit(const ModifiableTrit& trit)
+            : pos(trit.pos), set(trit.set), word(trit.word), shift(trit.shift) {}
+        
+        /** Обмен значений тритов, нужен алгоритмам над iterator. */
+        friend void swap(ModifiableTrit left, ModifiableTrit right) {
+            Trit trit = left;
+            left = Trit(right);
+            right = trit;
         }
         
     private:
         size_t pos;
         TritSet& set;
+        uint* word; // Слово с тритом или nullptr, если оно за пределами хранилища
+        uint shift;
+        
+        ModifiableTrit(TritSet& set, const size_t pos, uint* word = nullptr, uint shift = 0)
+            : pos(pos), set(set), word(word), shift(shift) {}
+    
+        friend TritSet;
+    };
+    
+    /**
+     * Итератор произвольного доступа для чтения тритов.
+     * Хранит текущее слово хранилища и при переходе к следующему
+     * триту сдвигает его, обращаясь к хранилищу раз в слово.
+     */
+    class const_iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef Trit value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Trit* pointer;
+        typedef Trit reference;
+        
+        const_iterator() : words(nullptr), wordsCount(0), pos(0), word(0) {}
+        
+        Trit operator*() const {
+            return tritFromCode(word & 0b11);
+        }
+        
+        Trit operator[](difference_type n) const {
+            return tritFromCode(load(pos + n) & 0b11);
+        }
+        
+        const_iterator& operator++() {
+            word >>= 2;
+            if (++pos % WORD_TRITS == 0)
+                word = load(pos);
+            return *this;
+        }
+        
+        const_iterator operator++(int) {
+            const_iterator it = *this;
+            ++*this;
+            return it;
+        }
+        
+        const_iterator& operator--() {
+            word = load(--pos);
+            return *this;
+        }
+        
+        const_iterator operator--(int) {
+            const_iterator it = *this;
+            --*this;
+            return it;
+        }
+        
+        const_iterator& operator+=(difference_type n) {
+            pos += n;
+            word = load(pos);
+            return *this;
+        }
+        
+        const_iterator& operator-=(difference_type n) {
+            return *this += -n;
+        }
         
-        ModifiableTrit(TritSet& set, const size_t pos): set(set), pos(pos) {}
+        const_iterator operator+(difference_type n) const {
+            return const_iterator(*this) += n;
+        }
+        
+        friend const_iterator operator+(difference_type n, const const_iterator& it) {
+            return it + n;
+        }
+        
+        const_iterator operator-(difference_type n) const {
+            return const_iterator(*this) -= n;
+        }
+        
+        difference_type operator-(const const_iterator& it) const {
+            return (difference_type) (pos - it.pos);
+        }
+        
+        bool operator==(const const_iterator& it) const { return pos == it.pos; }
+        bool operator!=(const const_iterator& it) const { return pos != it.pos; }
+        bool operator<(const const_iterator& it) const { return pos < it.pos; }
+        bool operator>(const const_iterator& it) const { return pos > it.pos; }
+        bool operator<=(const const_iterator& it) const { return pos <= it.pos; }
+        bool operator>=(const const_iterator& it) const { return pos >= it.pos; }
+        
+    private:
+        static const size_t WORD_TRITS = sizeof(uint) * 4;
+        
+        const uint* words;
+        size_t wordsCount;
+        size_t pos;
+        uint word; // Слово с текущим тритом в младших битах
+        
+        const_iterator(const uint* words, size_t wordsCount, size_t pos)
+            : words(words), wordsCount(wordsCount), pos(pos), word(load(pos)) {}
+        
+        uint load(size_t pos) const {
+            size_t index = pos / WORD_TRITS;
+            return index < wordsCount ? words[index] >> (pos % WORD_TRITS * 2) : 0;
+        }
+        
+        friend TritSet;
+    };
+    
+    /**
+     * Итератор произвольного доступа для чтения и записи тритов.
+     * Разыменование возвращает ModifiableTrit, который пишет прямо
+     * в слово хранилища. Хранит указатель на текущее слово и сдвиг
+     * трита в нем и пересчитывает их раз в слово.
+     * Как и итераторы std::vector, становится недействительным, если
+     * хранилище перераспределено: записью за пределы хранилища
+     * (после end()) или изменением размера набора.
+     */
+    class iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef Trit value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef ModifiableTrit reference;
+        
+        iterator() : set(nullptr), pos(0), word(nullptr), shift(0) {}
+        
+        ModifiableTrit operator*() const {
+            return ModifiableTrit(*set, pos, word, shift);
+        }
+        
+        ModifiableTrit operator[](difference_type n) const {
+            return *(*this + n);
+        }
+        
+        iterator& operator++() {
+            pos++;
+            if ((shift += 2) == WORD_TRITS * 2)
+                seek();
+            return *this;
+        }
+        
+        iterator& operator--() {
+            pos--;
+            if (shift)
+                shift -= 2;
+            else
+                seek();
+            return *this;
+        }
+        
+        iterator operator++(int) {
+            iterator it = *this;
+            ++*this;
+            return it;
+        }
+        
+        iterator operator--(int) {
+            iterator it = *this;
+            --*this;
+            return it;
+        }
+        
+        iterator& operator+=(difference_type n) {
+            pos += n;
+            seek();
+            return *this;
+        }
+        
+        iterator& operator-=(difference_type n) {
+            return *this += -n;
+        }
+        
+        iterator operator+(difference_type n) const {
+            return iterator(*this) += n;
+        }
         
-        ModifiableTrit(const ModifiableTrit& trit): set(trit.set), pos(trit.pos) {}
+        iterator operator-(difference_type n) const {
+            return iterator(*this) -= n;
+        }
+        
+        friend iterator operator+(difference_type n, const iterator& it) {
+            return it + n;
+        }
+        
+        difference_type operator-(const iterator& it) const {
+            return (difference_type) (pos - it.pos);
+        }
+        
+        bool operator==(const iterator& it) const { return pos == it.pos; }
+        bool operator!=(const iterator& it) const { return pos != it.pos; }
+        bool operator<(const iterator& it) const { return pos < it.pos; }
+        bool operator>(const iterator& it) const { return pos > it.pos; }
+        bool operator<=(const iterator& it) const { return pos <= it.pos; }
+        bool operator>=(const iterator& it) const { return pos >= it.pos; }
+        
+    private:
+        static const size_t WORD_TRITS = sizeof(uint) * 4;
+        
+        TritSet* set;
+        size_t pos;
+        uint* word; // Слово с текущим тритом или nullptr за пределами хранилища
+        uint shift; // Сдвиг текущего трита в слове
+        
+        iterator(TritSet* set, size_t pos) : set(set), pos(pos) {
+            seek();
+        }
+        
+        /** Пересчитывает слово и сдвиг по позиции. */
+        void seek() {
+            size_t index = pos / WORD_TRITS;
+            word = index < set->storage.size() ? set->storage.data() + index : nullptr;
+            shift = (uint) (pos % WORD_TRITS * 2);
+        }
         
-        ModifiableTrit& operator=(ModifiableTrit const&) = delete;
+        friend TritSet;
+    };
     
+    /**
+     * Диапазон позиций тритов одного значения.
+     * @see positions(Trit)
+     */
+    class Positions {
+    public:
+        
+        class iterator {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef size_t value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const size_t* pointer;
+            typedef size_t reference;
+            
+            iterator() : set(nullptr), trit(Unknown), pos(npos) {}
+            
+            size_t operator*() const {
+                return pos;
+            }
+            
+            iterator& operator++() {
+                pos = set->findNext(trit, pos);
+                return *this;
+            }
+            
+            iterator operator++(int) {
+                iterator it = *this;
+                ++*this;
+                return it;
+            }
+            
+            bool operator==(const iterator& it) const { return pos == it.pos; }
+            bool operator!=(const iterator& it) const { return pos != it.pos; }
+            
+        private:
+            const TritSet* set;
+            Trit trit;
+            size_t pos;
+            
+            iterator(const TritSet* set, Trit trit, size_t pos) : set(set), trit(trit), pos(pos) {}
+            
+            friend Positions;
+        };
+        
+        iterator begin() const {
+            return iterator(set, trit, set->findFirst(trit));
+        }
+        
+        iterator end() const {
+            return iterator(set, trit, npos);
+        }
+        
+    private:
+        const TritSet* set;
+        Trit trit;
+        
+        Positions(const TritSet* set, Trit trit) : set(set), trit(trit) {}
+        
         friend TritSet;
     };
     
@@ -189,16 +689,131 @@ private:
      */
     void _setTrit(size_t pos, Trit value);
     
+    /**
+     * Обновляет позицию последнего не Unknown трита после записи
+     * одного трита.
+     * @param pos Позиция записанного трита.
+     * @param value Записанное значение.
+     */
+    void updateLastTritPos(size_t pos, Trit value);
+    
     /**
      * Подсчитывает позицию последнего не Unkwnown трита.
      */
     void countLastTritPos();
 };
 
-/** Тритовые операции. */
+/**
+ * Тритовые операции.
+ *
+ * Значения упорядочены False < Unknown < True, поэтому операции
+ * вычисляются арифметикой без ветвлений: AND - минимум, OR - максимум,
+ * NOT - отражение 2 - t. Все операции constexpr и встраиваются
+ * в поэлементные циклы вызывающего кода.
+ */
+
+constexpr Trit operator~(const Trit& trit) {
+    return Trit(True - trit);
+}
+
+constexpr Trit operator&(const Trit& left, const Trit& right) {
+    return left < right ? left : right;
+}
+
+constexpr Trit operator|(const Trit& left, const Trit& right) {
+    return left > right ? left : right;
+}
+
+/**
+ * XOR Клини: (left | right) & ~(left & right).
+ */
+constexpr Trit operator^(const Trit& left, const Trit& right) {
+    return (left | right) & ~(left & right);
+}
+
+/**
+ * Консенсус: значение, если триты совпадают, иначе Unknown.
+ */
+constexpr Trit tritConsensus(Trit left, Trit right) {
+    return left == right ? left : Unknown;
+}
+
+/**
+ * Импликация Клини: ~left | right.
+ * В отличие от импликации Лукасевича, Unknown -> Unknown = Unknown.
+ */
+constexpr Trit tritImplies(Trit left, Trit right) {
+    return ~left | right;
+}
+
+/**
+ * Эквивалентность Клини: (left -> right) & (right -> left).
+ */
+constexpr Trit tritEquivalent(Trit left, Trit right) {
+    return tritImplies(left, right) & tritImplies(right, left);
+}
+
+/**
+ * Импликация Лукасевича: min(True, True - left + right).
+ * Unknown -> Unknown = True.
+ */
+constexpr Trit tritLukasiewiczImplies(Trit left, Trit right) {
+    return left <= right ? True : Trit(True - left + right);
+}
 
-Trit operator~(const Trit& trit);
-Trit operator&(const Trit& left, const Trit& right);
-Trit operator|(const Trit& left, const Trit& right);
+/**
+ * Эквивалентность Лукасевича: True - |left - right|.
+ */
+constexpr Trit tritLukasiewiczEquivalent(Trit left, Trit right) {
+    return Trit(True - (left > right ? left - right : right - left));
+}
+
+/**
+ * Сильная конъюнкция Лукасевича: max(False, left + right - True).
+ */
+constexpr Trit tritLukasiewiczAnd(Trit left, Trit right) {
+    return left + right <= True ? False : Trit(left + right - True);
+}
+
+/**
+ * Сильная дизъюнкция Лукасевича: min(True, left + right).
+ */
+constexpr Trit tritLukasiewiczOr(Trit left, Trit right) {
+    return left + right >= True ? True : Trit(left + right);
+}
+
+/** Текстовое представление: по символу F, U или T на трит. */
+
+/**
+ * Вывод в поток.
+ */
+std::ostream& operator<<(std::ostream& stream, const TritSet& set);
+
+/**
+ * Чтение из потока. Пропускает ведущие пробелы и читает слово
+ * из символов F, U, T (в любом регистре). Если слово содержит
+ * другие символы, у потока устанавливается failbit.
+ */
+std::istream& operator>>(std::istream& stream, TritSet& set);
+
+/**
+ * Записывает текстовое представление набора тритов в буфер.
+ * @param first Начало буфера.
+ * @param last Конец буфера.
+ * @param set Набор тритов.
+ * @return Указатель за последним записанным символом
+ * или nullptr, если набор не поместился в буфер.
+ */
+char* tritSetToChars(char* first, char* last, const TritSet& set);
+
+/**
+ * Читает набор тритов из текстового представления.
+ * Чтение останавливается на первом символе, отличном от F, U, T.
+ * @param first Начало текста.
+ * @param last Конец текста.
+ * @param set Прочитанный набор тритов.
+ * @return Указатель на первый непрочитанный символ.
+ */
+const char* tritSetFromChars(const char* first, const char* last, TritSet& set);
 
 #endif /* TritSet_h */
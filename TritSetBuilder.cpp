@@ -0,0 +1,63 @@
+//
+//  TritSetBuilder.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include "TritSetBuilder.h"
+#include "TritWord.h"
+
+TritSetBuilder::TritSetBuilder(size_t tritsCount) : length(0) {
+    reserve(tritsCount);
+}
+
+TritSetBuilder::TritSetBuilder(const TritSet& set) : storage(set.words()), length(set.size()) {}
+
+size_t TritSetBuilder::size() const {
+    return length;
+}
+
+void TritSetBuilder::reserve(size_t tritsCount) {
+    storage.reserve(tritWordsCount(tritsCount));
+}
+
+TritSetBuilder& TritSetBuilder::setWord(size_t index, uint word) {
+    if (index >= storage.size())
+        storage.resize(index + 1);
+    
+    storage[index] = word;
+    
+    if ((index + 1) * TRITS_PER_WORD > length)
+        length = (index + 1) * TRITS_PER_WORD;
+    return *this;
+}
+
+TritSetBuilder& TritSetBuilder::appendWord(uint word, size_t count) {
+    if (!count)
+        return *this;
+    
+    word &= tritWordLowMask(count);
+    if (storage.size() < tritWordsCount(length + count))
+        storage.resize(tritWordsCount(length + count));
+    
+    // Триты после size() нулевые, поэтому слово можно добавить через OR
+    size_t shift = length % TRITS_PER_WORD;
+    storage[length / TRITS_PER_WORD] |= word << (shift * 2);
+    if (shift + count > TRITS_PER_WORD)
+        storage[length / TRITS_PER_WORD + 1] |= word >> ((TRITS_PER_WORD - shift) * 2);
+    
+    length += count;
+    return *this;
+}
+
+TritSet TritSetBuilder::build() {
+    // Слова после последнего трита, например скопированные из исходного набора
+    storage.resize(tritWordsCount(length));
+    
+    TritSet set = TritSet::fromWords(std::move(storage));
+    storage.clear();
+    length = 0;
+    return set;
+}
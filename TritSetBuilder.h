@@ -0,0 +1,107 @@
+//
+//  TritSetBuilder.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritSetBuilder_h
+#define TritSetBuilder_h
+
+#include <cstddef>
+#include <vector>
+
+#include "TritSet.h"
+#include "TritWord.h"
+
+/**
+ * Построитель набора тритов для массовой загрузки данных.
+ *
+ * В отличие от TritSet::setTrit, запись трита не проверяет старое
+ * значение и не пересчитывает позицию последнего трита: она вычисляется
+ * один раз в build(). Запись идет напрямую в слова, без ModifiableTrit.
+ */
+class TritSetBuilder {
+public:
+    
+    /**
+     * @param tritsCount Кол-во тритов, под которые сразу выделяется память.
+     */
+    explicit TritSetBuilder(size_t tritsCount = 0);
+    
+    /**
+     * Продолжает построение существующего набора, копируя его триты.
+     * Добавление начинается с позиции set.size().
+     * @param set Набор тритов.
+     */
+    explicit TritSetBuilder(const TritSet& set);
+    
+    /**
+     * Позиция, на которую будет добавлен следующий трит:
+     * наибольшая записанная позиция + 1.
+     */
+    size_t size() const;
+    
+    /**
+     * Выделяет память под tritsCount тритов, не меняя size().
+     */
+    void reserve(size_t tritsCount);
+    
+    /**
+     * Записывает трит на позицию, выделяя память при необходимости.
+     * @param pos Позиция трита.
+     * @param trit Значение.
+     * @return Этот построитель.
+     */
+    TritSetBuilder& set(size_t pos, Trit trit) {
+        size_t index = pos / TRITS_PER_WORD;
+        if (index >= storage.size())
+            storage.resize(index + 1);
+        
+        size_t shift = pos % TRITS_PER_WORD * 2;
+        storage[index] = (storage[index] & ~((uint) 0b11 << shift)) | (tritCode(trit) << shift);
+        
+        if (pos >= length)
+            length = pos + 1;
+        return *this;
+    }
+    
+    /**
+     * Добавляет трит на позицию size().
+     * @param trit Значение.
+     * @return Этот построитель.
+     */
+    TritSetBuilder& append(Trit trit) {
+        return set(length, trit);
+    }
+    
+    /**
+     * Записывает сразу 16 тритов слова хранилища.
+     * @param index Номер слова, триты [index * 16, index * 16 + 16).
+     * @param word Слово в формате хранилища TritSet (коды 0b11 недопустимы).
+     * @return Этот построитель.
+     */
+    TritSetBuilder& setWord(size_t index, uint word);
+    
+    /**
+     * Добавляет count первых тритов слова на позицию size().
+     * @param word Слово в формате хранилища TritSet.
+     * @param count Кол-во тритов, не больше 16.
+     * @return Этот построитель.
+     */
+    TritSetBuilder& appendWord(uint word, size_t count = TRITS_PER_WORD);
+    
+    /**
+     * Завершает построение. Построитель становится пустым.
+     * @return Набор тритов, позиция последнего трита вычисляется один раз.
+     */
+    TritSet build();
+
+private:
+    // Слова до последнего записанного, емкость растет геометрически
+    std::vector<uint> storage;
+    size_t length;
+};
+
+#endif /* TritSetBuilder_h */
@@ -0,0 +1,166 @@
+//
+//  TritSetView.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+
+#include "TritSetView.h"
+#include "TritWord.h"
+
+/**
+ * Длина среза, ограниченная концом данных при длине по умолчанию.
+ */
+static size_t viewLength(size_t tritsCount, size_t start, size_t length) {
+    if (length != TritSet::npos)
+        return length;
+    return start < tritsCount ? tritsCount - start : 0;
+}
+
+TritSetView::TritSetView() : words(nullptr), wordsAvailable(0), start(0), length(0) {}
+
+TritSetView::TritSetView(const TritSet& set, size_t start, size_t length)
+    : words(set.words().data()), wordsAvailable(set.words().size()),
+      start(start), length(viewLength(set.size(), start, length)) {}
+
+TritSetView::TritSetView(const MappedTritSet& set, size_t start, size_t length)
+    : TritSetView(set.words(), set.size(), start, length) {}
+
+TritSetView::TritSetView(const uint* words, size_t tritsCount, size_t start, size_t length)
+    : words(words), wordsAvailable(tritWordsCount(tritsCount)),
+      start(start), length(viewLength(tritsCount, start, length)) {}
+
+size_t TritSetView::size() const {
+    return length;
+}
+
+Trit TritSetView::getTrit(size_t pos) const {
+    if (pos >= length)
+        return Unknown;
+    
+    pos += start;
+    return tritFromCode((load(pos / TRITS_PER_WORD) >> (pos % TRITS_PER_WORD * 2)) & 0b11);
+}
+
+Trit TritSetView::operator[](size_t pos) const {
+    return getTrit(pos);
+}
+
+TritSetView TritSetView::subview(size_t start, size_t length) const {
+    TritSetView view = *this;
+    
+    if (start > this->length)
+        start = this->length;
+    if (length > this->length - start)
+        length = this->length - start;
+    
+    view.start = this->start + start;
+    view.length = length;
+    return view;
+}
+
+size_t TritSetView::wordsCount() const {
+    return tritWordsCount(length);
+}
+
+uint TritSetView::word(size_t index) const {
+    if (index >= wordsCount())
+        return 0;
+    
+    size_t pos = start + index * TRITS_PER_WORD;
+    size_t first = pos / TRITS_PER_WORD;
+    size_t shift = pos % TRITS_PER_WORD * 2;
+    
+    // Склеиваем слово среза из двух соседних слов хранилища
+    uint word = load(first) >> shift;
+    if (shift)
+        word |= load(first + 1) << (sizeof(uint) * 8 - shift);
+    
+    size_t tail = length - index * TRITS_PER_WORD;
+    if (tail < TRITS_PER_WORD)
+        word &= ((uint) 1 << (tail * 2)) - 1;
+    
+    return word;
+}
+
+size_t TritSetView::cardinality(Trit trit) const {
+    if (trit == Unknown)
+        return length - cardinality(False) - cardinality(True);
+    
+    size_t count = 0;
+    for (size_t i = 0; i < wordsCount(); i++)
+        count += wordPopcount(tritWordMatch(word(i), trit));
+    
+    return count;
+}
+
+TritSet TritSetView::toTritSet() const {
+    std::vector<uint> result(wordsCount());
+    for (size_t i = 0; i < result.size(); i++)
+        result[i] = word(i);
+    
+    return TritSet::fromWords(std::move(result));
+}
+
+uint TritSetView::load(size_t index) const {
+    return index < wordsAvailable ? words[index] : 0;
+}
+
+bool operator==(const TritSetView& left, const TritSetView& right) {
+    size_t count = std::max(left.wordsCount(), right.wordsCount());
+    
+    for (size_t i = 0; i < count; i++)
+        if (left.word(i) != right.word(i))
+            return false;
+    
+    return true;
+}
+
+bool operator!=(const TritSetView& left, const TritSetView& right) {
+    return !(left == right);
+}
+
+size_t tritViewNot(const TritSetView& view, uint* destination) {
+    size_t count = view.wordsCount();
+    for (size_t i = 0; i < count; i++)
+        destination[i] = tritWordNot(view.word(i));
+    
+    return count;
+}
+
+size_t tritViewAnd(const TritSetView& left, const TritSetView& right, uint* destination) {
+    size_t count = std::max(left.wordsCount(), right.wordsCount());
+    for (size_t i = 0; i < count; i++)
+        destination[i] = tritWordAnd(left.word(i), right.word(i));
+    
+    return count;
+}
+
+size_t tritViewOr(const TritSetView& left, const TritSetView& right, uint* destination) {
+    size_t count = std::max(left.wordsCount(), right.wordsCount());
+    for (size_t i = 0; i < count; i++)
+        destination[i] = tritWordOr(left.word(i), right.word(i));
+    
+    return count;
+}
+
+TritSet operator~(const TritSetView& view) {
+    std::vector<uint> result(view.wordsCount());
+    tritViewNot(view, result.data());
+    return TritSet::fromWords(std::move(result));
+}
+
+TritSet operator&(const TritSetView& left, const TritSetView& right) {
+    std::vector<uint> result(std::max(left.wordsCount(), right.wordsCount()));
+    tritViewAnd(left, right, result.data());
+    return TritSet::fromWords(std::move(result));
+}
+
+TritSet operator|(const TritSetView& left, const TritSetView& right) {
+    std::vector<uint> result(std::max(left.wordsCount(), right.wordsCount()));
+    tritViewOr(left, right, result.data());
+    return TritSet::fromWords(std::move(result));
+}
@@ -0,0 +1,141 @@
+//
+//  TritSetView.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritSetView_h
+#define TritSetView_h
+
+#include <cstddef>
+
+#include "MappedTritSet.h"
+#include "TritSet.h"
+
+/**
+ * Невладеющий срез набора тритов: триты [start, start + length)
+ * слов хранилища TritSet, MappedTritSet или произвольного буфера.
+ *
+ * Срез не копирует данные, но читает его словами по 16 тритов:
+ * при невыровненном начале слово среза склеивается из двух соседних
+ * слов хранилища сдвигами. Триты за пределами хранилища считаются Unknown.
+ *
+ * Хранилище не должно изменяться или уничтожаться, пока используется срез.
+ */
+class TritSetView {
+public:
+    
+    /**
+     * Пустой срез.
+     */
+    TritSetView();
+    
+    /**
+     * Срез набора тритов.
+     * @param set Набор тритов.
+     * @param start Позиция первого трита среза.
+     * @param length Длина среза, по умолчанию до конца набора.
+     */
+    TritSetView(const TritSet& set, size_t start = 0, size_t length = TritSet::npos);
+    
+    /**
+     * Срез отображенного набора тритов.
+     * @see TritSetView(const TritSet&, size_t, size_t)
+     */
+    TritSetView(const MappedTritSet& set, size_t start = 0, size_t length = TritSet::npos);
+    
+    /**
+     * Срез слов хранилища.
+     * @param words Слова в формате хранилища TritSet.
+     * @param tritsCount Кол-во тритов в словах.
+     * @param start Позиция первого трита среза.
+     * @param length Длина среза, по умолчанию до tritsCount.
+     */
+    TritSetView(const uint* words, size_t tritsCount,
+                size_t start = 0, size_t length = TritSet::npos);
+    
+    /**
+     * Длина среза.
+     */
+    size_t size() const;
+    
+    /**
+     * Получение трита среза.
+     * @param pos Позиция относительно начала среза.
+     * @return Трит или Unknown за пределами среза.
+     */
+    Trit getTrit(size_t pos) const;
+    
+    /**
+     * @see getTrit(size_t)
+     */
+    Trit operator[](size_t pos) const;
+    
+    /**
+     * Срез этого среза.
+     * @param start Позиция относительно начала среза.
+     * @param length Длина, ограничивается концом среза.
+     */
+    TritSetView subview(size_t start, size_t length = TritSet::npos) const;
+    
+    /**
+     * Кол-во слов, покрывающих срез.
+     */
+    size_t wordsCount() const;
+    
+    /**
+     * Слово среза в формате хранилища TritSet.
+     * Триты после конца среза в последнем слове обнулены.
+     * @param index Номер слова, за пределами среза возвращается 0.
+     */
+    uint word(size_t index) const;
+    
+    /**
+     * Кол-во тритов данного значения в срезе.
+     */
+    size_t cardinality(Trit trit) const;
+    
+    /**
+     * Копирует срез в новый набор тритов, начиная с позиции 0.
+     */
+    TritSet toTritSet() const;
+
+private:
+    const uint* words;
+    size_t wordsAvailable;
+    size_t start;
+    size_t length;
+    
+    uint load(size_t index) const;
+};
+
+/**
+ * Сравнение срезов, как у TritSet: отсутствующие триты считаются Unknown.
+ */
+bool operator==(const TritSetView& left, const TritSetView& right);
+bool operator!=(const TritSetView& left, const TritSetView& right);
+
+/**
+ * Логические операции над срезами с записью в слова назначения.
+ * Результат начинается с позиции 0, длина берется по большему срезу.
+ * @param destination Слова результата, не меньше wordsCount() большего среза.
+ * Могут совпадать с началом слов хранилища одного из срезов:
+ * каждое слово хранилища читается до того, как оно перезаписывается.
+ * @return Кол-во записанных слов.
+ */
+size_t tritViewNot(const TritSetView& view, uint* destination);
+size_t tritViewAnd(const TritSetView& left, const TritSetView& right, uint* destination);
+size_t tritViewOr(const TritSetView& left, const TritSetView& right, uint* destination);
+
+/**
+ * Логические операции над срезами. Результат записывается в новый
+ * набор тритов с позиции 0, длина берется по большему срезу.
+ * @see tritViewAnd(const TritSetView&, const TritSetView&, uint*)
+ */
+TritSet operator~(const TritSetView& view);
+TritSet operator&(const TritSetView& left, const TritSetView& right);
+TritSet operator|(const TritSetView& left, const TritSetView& right);
+
+#endif /* TritSetView_h */
@@ -0,0 +1,167 @@
+//
+//  TritText.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstring>
+#include <string>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "TritSet.h"
+#include "TritWord.h"
+
+/**
+ * Таблицы перевода между словами хранилища и символами.
+ */
+struct TritTextTables {
+    char chars[256][4];     // Символы четырех тритов каждого байта хранилища
+    signed char codes[256]; // Код трита каждого символа или -1
+    
+    TritTextTables() {
+        const char symbols[] = {'U', 'F', 'T', '?'};
+        
+        for (size_t byte = 0; byte < 256; byte++)
+            for (size_t i = 0; i < 4; i++)
+                chars[byte][i] = symbols[(byte >> (i * 2)) & 0b11];
+        
+        std::memset(codes, -1, sizeof(codes));
+        codes['F'] = codes['f'] = 0b01;
+        codes['U'] = codes['u'] = 0b00;
+        codes['T'] = codes['t'] = 0b10;
+    }
+};
+
+static const TritTextTables tables;
+
+/**
+ * Записывает символы первых tritsCount тритов.
+ * @return Указатель за последним записанным символом.
+ */
+static char* formatWords(const uint* words, size_t tritsCount, char* out) {
+    size_t full = tritsCount / TRITS_PER_WORD;
+    
+    for (size_t i = 0; i < full; i++) {
+        uint word = words[i];
+        for (size_t byte = 0; byte < sizeof(uint); byte++, word >>= 8, out += 4)
+            std::memcpy(out, tables.chars[word & 0xFF], 4);
+    }
+    
+    size_t tail = tritsCount % TRITS_PER_WORD;
+    for (size_t i = 0; i < tail; i++)
+        *out++ = tables.chars[(words[full] >> (i * 2)) & 0b11][0];
+    
+    return out;
+}
+
+/**
+ * Разбирает TRITS_PER_WORD символов в одно слово хранилища.
+ * @return Все ли символы являются тритами.
+ */
+static bool parseWord(const char* text, uint& word) {
+#ifdef __SSE2__
+    __m128i chars = _mm_loadu_si128((const __m128i*) text);
+    __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    
+    __m128i isFalse = _mm_cmpeq_epi8(lower, _mm_set1_epi8('f'));
+    __m128i isUnknown = _mm_cmpeq_epi8(lower, _mm_set1_epi8('u'));
+    __m128i isTrue = _mm_cmpeq_epi8(lower, _mm_set1_epi8('t'));
+    
+    __m128i valid = _mm_or_si128(_mm_or_si128(isFalse, isUnknown), isTrue);
+    if (_mm_movemask_epi8(valid) != 0xFFFF)
+        return false;
+    
+    word = wordSpreadBits(_mm_movemask_epi8(isFalse))
+        | (wordSpreadBits(_mm_movemask_epi8(isTrue)) << 1);
+    return true;
+#else
+    uint result = 0;
+    int invalid = 0;
+    
+    for (size_t i = 0; i < TRITS_PER_WORD; i++) {
+        int code = tables.codes[(unsigned char) text[i]];
+        invalid |= code;
+        result |= (uint) (code & 0b11) << (i * 2);
+    }
+    
+    word = result;
+    return invalid >= 0;
+#endif
+}
+
+char* tritSetToChars(char* first, char* last, const TritSet& set) {
+    if ((size_t) (last - first) < set.size())
+        return nullptr;
+    
+    return formatWords(set.words().data(), set.size(), first);
+}
+
+const char* tritSetFromChars(const char* first, const char* last, TritSet& set) {
+    std::vector<uint> words;
+    words.reserve(tritWordsCount(last - first));
+    
+    const char* pos = first;
+    uint word;
+    
+    while ((size_t) (last - pos) >= TRITS_PER_WORD && parseWord(pos, word)) {
+        words.push_back(word);
+        pos += TRITS_PER_WORD;
+    }
+    
+    // Остаток, а также слово с недопустимым символом, разбираем посимвольно
+    word = 0;
+    size_t count = 0;
+    
+    for (; pos != last && tables.codes[(unsigned char) *pos] >= 0; pos++) {
+        word |= (uint) tables.codes[(unsigned char) *pos] << (count * 2);
+        
+        if (++count == TRITS_PER_WORD) {
+            words.push_back(word);
+            word = 0;
+            count = 0;
+        }
+    }
+    
+    if (count)
+        words.push_back(word);
+    
+    set = TritSet::fromWords(std::move(words));
+    return pos;
+}
+
+std::ostream& operator<<(std::ostream& stream, const TritSet& set) {
+    const size_t blockTrits = 4096;
+    char buffer[blockTrits];
+    
+    const uint* words = set.words().data();
+    size_t size = set.size();
+    
+    for (size_t pos = 0; pos < size; pos += blockTrits) {
+        size_t count = size - pos < blockTrits ? size - pos : blockTrits;
+        char* end = formatWords(words + pos / TRITS_PER_WORD, count, buffer);
+        stream.write(buffer, end - buffer);
+    }
+    
+    return stream;
+}
+
+std::istream& operator>>(std::istream& stream, TritSet& set) {
+    std::string text;
+    if (!(stream >> text))
+        return stream;
+    
+    TritSet result;
+    const char* end = text.data() + text.size();
+    
+    if (tritSetFromChars(text.data(), end, result) != end)
+        stream.setstate(std::ios::failbit);
+    else
+        set = std::move(result);
+    
+    return stream;
+}
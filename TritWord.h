@@ -0,0 +1,379 @@
+//
+//  TritWord.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef TritWord_h
+#define TritWord_h
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "TritSet.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * Пословные операции над хранилищем тритов.
+ *
+ * Каждый трит занимает два бита слова: младший бит (False) и
+ * старший бит (True). Unknown кодируется нулями, поэтому все, что
+ * лежит за последним установленным тритом, - нулевые слова.
+ */
+
+static_assert(sizeof(uint) == 4, "Trit words are expected to be 32 bit");
+
+/** Кол-во тритов в одном слове хранилища. */
+constexpr size_t TRITS_PER_WORD = sizeof(uint) * CHAR_BIT / 2;
+
+/** Маска битов False всех тритов слова (0b0101...). */
+constexpr uint FALSE_PLANE = (uint) ~(uint) 0 / 3;
+
+/** Маска битов True всех тритов слова (0b1010...). */
+constexpr uint TRUE_PLANE = FALSE_PLANE << 1;
+
+/**
+ * Кол-во слов, необходимое для хранения заданного кол-ва тритов.
+ * Не переполняется, поэтому годится для проверки размеров из файлов.
+ */
+constexpr size_t tritWordsCount(size_t tritsCount) {
+    return tritsCount / TRITS_PER_WORD + (tritsCount % TRITS_PER_WORD != 0);
+}
+
+/** Логическое NOT для всех тритов слова. */
+constexpr uint tritWordNot(uint word) {
+    return ((word & FALSE_PLANE) << 1) | ((word >> 1) & FALSE_PLANE);
+}
+
+/** Логическое AND для всех тритов слова. */
+constexpr uint tritWordAnd(uint left, uint right) {
+    return ((left | right) & FALSE_PLANE) | (left & right & TRUE_PLANE);
+}
+
+/** Логическое OR для всех тритов слова. */
+constexpr uint tritWordOr(uint left, uint right) {
+    return (left & right & FALSE_PLANE) | ((left | right) & TRUE_PLANE);
+}
+
+/** Импликация Клини (~left | right) для всех тритов слова. */
+constexpr uint tritWordImplies(uint left, uint right) {
+    return ((left >> 1) & right & FALSE_PLANE) | (((left << 1) | right) & TRUE_PLANE);
+}
+
+/** Маска младших битов известных (не Unknown) тритов слова. */
+constexpr uint tritWordKnown(uint word) {
+    return (word | (word >> 1)) & FALSE_PLANE;
+}
+
+/** XOR Клини для всех тритов слова: True, если оба трита известны и различны. */
+constexpr uint tritWordXor(uint left, uint right) {
+    return (tritWordKnown(left) & tritWordKnown(right) & ~((left ^ right) >> 1))
+        | ((tritWordKnown(left) & tritWordKnown(right) & ((left ^ right) >> 1)) << 1);
+}
+
+/** Эквивалентность Клини для всех тритов слова: NOT XOR. */
+constexpr uint tritWordEquivalent(uint left, uint right) {
+    return tritWordNot(tritWordXor(left, right));
+}
+
+/**
+ * Консенсус для всех тритов слова: трит известен, только если
+ * оба трита известны и совпадают. Совпадает с побитовым AND кодов.
+ */
+constexpr uint tritWordConsensus(uint left, uint right) {
+    return left & right;
+}
+
+/**
+ * Слово, все триты которого установлены в данное значение.
+ */
+constexpr uint tritWordFill(Trit trit) {
+    return trit == False ? FALSE_PLANE : (trit == True ? TRUE_PLANE : 0);
+}
+
+/**
+ * Маска младших битов тритов слова, равных данному значению.
+ * Для Unknown включает и неиспользуемые триты в конце слова.
+ */
+constexpr uint tritWordMatch(uint word, Trit trit) {
+    return trit == False ? word & FALSE_PLANE
+        : (trit == True ? (word >> 1) & FALSE_PLANE : ~(word | (word >> 1)) & FALSE_PLANE);
+}
+
+/**
+ * Раздвигает младшие 16 бит в четные биты слова: бит i -> бит 2i.
+ * Так маска тритов превращается в биты False слова хранилища.
+ */
+constexpr uint wordSpreadBits(uint bits) {
+    bits &= 0xFFFF;
+    bits = (bits | (bits << 8)) & 0x00FF00FF;
+    bits = (bits | (bits << 4)) & 0x0F0F0F0F;
+    bits = (bits | (bits << 2)) & 0x33333333;
+    return (bits | (bits << 1)) & 0x55555555;
+}
+
+/**
+ * Обратное к wordSpreadBits: четные биты слова -> младшие 16 бит.
+ */
+constexpr uint wordCompactBits(uint bits) {
+    bits &= 0x55555555;
+    bits = (bits | (bits >> 1)) & 0x33333333;
+    bits = (bits | (bits >> 2)) & 0x0F0F0F0F;
+    bits = (bits | (bits >> 4)) & 0x00FF00FF;
+    return (bits | (bits >> 8)) & 0x0000FFFF;
+}
+
+/** Кол-во установленных битов слова. */
+inline size_t wordPopcount(uint word) {
+#ifdef _MSC_VER
+    return __popcnt(word);
+#else
+    return __builtin_popcount(word);
+#endif
+}
+
+/** Индекс младшего установленного бита. Слово не должно быть нулевым. */
+inline size_t wordLowestBit(uint word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, word);
+    return index;
+#else
+    return __builtin_ctz(word);
+#endif
+}
+
+/** Кол-во установленных битов 64-битного слова. */
+inline size_t wordPopcount64(uint64_t word) {
+#ifdef _MSC_VER
+    return __popcnt64(word);
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+/** Индекс младшего установленного бита 64-битного слова. Слово не должно быть нулевым. */
+inline size_t wordLowestBit64(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/** Индекс старшего установленного бита. Слово не должно быть нулевым. */
+inline size_t wordHighestBit(uint word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, word);
+    return index;
+#else
+    return sizeof(uint) * CHAR_BIT - 1 - __builtin_clz(word);
+#endif
+}
+
+/**
+ * Поэлементно применяет пословную операцию к двум массивам слов.
+ * Более короткий массив дополняется словами из Unknown тритов.
+ *
+ * @param left Левый операнд.
+ * @param leftCount Кол-во слов левого операнда.
+ * @param right Правый операнд.
+ * @param rightCount Кол-во слов правого операнда.
+ * @param result Результат, не менее max(leftCount, rightCount) слов.
+ * @param op Операция над парой слов.
+ */
+template <typename Op>
+void tritWordsZip(const uint* left, size_t leftCount,
+                  const uint* right, size_t rightCount,
+                  uint* result, Op op) {
+    size_t common = leftCount < rightCount ? leftCount : rightCount;
+    
+    for (size_t i = 0; i < common; i++)
+        result[i] = op(left[i], right[i]);
+    for (size_t i = common; i < leftCount; i++)
+        result[i] = op(left[i], 0);
+    for (size_t i = common; i < rightCount; i++)
+        result[i] = op(0, right[i]);
+}
+
+/**
+ * Подсчитывает кол-во тритов данного значения в первых tritsCount тритах.
+ */
+inline size_t tritWordsCardinality(const uint* words, size_t tritsCount, Trit trit) {
+    size_t full = tritsCount / TRITS_PER_WORD;
+    size_t count = 0;
+    
+    for (size_t i = 0; i < full; i++)
+        count += wordPopcount(tritWordMatch(words[i], trit));
+    
+    size_t tail = tritsCount % TRITS_PER_WORD;
+    if (tail)
+        count += wordPopcount(tritWordMatch(words[full], trit)
+                              & (((uint) 1 << (tail * 2)) - 1));
+    
+    return count;
+}
+
+/**
+ * Позиция последнего не Unknown трита.
+ * @return Позиция трита или wordsCount * TRITS_PER_WORD, если таких тритов нет.
+ */
+inline size_t tritWordsLastKnown(const uint* words, size_t wordsCount) {
+    for (size_t i = wordsCount; i > 0; i--)
+        if (words[i - 1])
+            return (i - 1) * TRITS_PER_WORD + wordHighestBit(words[i - 1]) / 2;
+    return wordsCount * TRITS_PER_WORD;
+}
+
+/**
+ * Ищет первый трит данного значения на позиции не меньше from.
+ * @param words Слова хранилища.
+ * @param tritsCount Кол-во тритов, в которых ведется поиск.
+ * @param trit Искомое значение.
+ * @param from Позиция начала поиска.
+ * @return Позиция трита или tritsCount, если трит не найден.
+ */
+inline size_t tritWordsFindNext(const uint* words, size_t tritsCount, Trit trit, size_t from) {
+    if (from >= tritsCount)
+        return tritsCount;
+    
+    size_t index = from / TRITS_PER_WORD;
+    size_t last = (tritsCount - 1) / TRITS_PER_WORD;
+    uint mask = tritWordMatch(words[index], trit) & (FALSE_PLANE << (from % TRITS_PER_WORD * 2));
+    
+    while (!mask) {
+        if (index == last)
+            return tritsCount;
+        mask = tritWordMatch(words[++index], trit);
+    }
+    
+    size_t pos = index * TRITS_PER_WORD + wordLowestBit(mask) / 2;
+    return pos < tritsCount ? pos : tritsCount;
+}
+
+/**
+ * Ищет последний трит данного значения на позиции меньше before.
+ * @param words Слова хранилища.
+ * @param tritsCount Кол-во тритов, в которых ведется поиск.
+ * @param trit Искомое значение.
+ * @param before Позиция окончания поиска (не включается).
+ * @return Позиция трита или tritsCount, если трит не найден.
+ */
+inline size_t tritWordsFindPrev(const uint* words, size_t tritsCount, Trit trit, size_t before) {
+    if (before > tritsCount)
+        before = tritsCount;
+    if (!before)
+        return tritsCount;
+    
+    size_t index = (before - 1) / TRITS_PER_WORD;
+    size_t unused = TRITS_PER_WORD - 1 - (before - 1) % TRITS_PER_WORD;
+    uint mask = tritWordMatch(words[index], trit) & (FALSE_PLANE >> (unused * 2));
+    
+    while (!mask) {
+        if (!index)
+            return tritsCount;
+        mask = tritWordMatch(words[--index], trit);
+    }
+    
+    return index * TRITS_PER_WORD + wordHighestBit(mask) / 2;
+}
+
+/**
+ * Маска младших count тритов слова.
+ */
+constexpr uint tritWordLowMask(size_t count) {
+    return count >= TRITS_PER_WORD ? ~(uint) 0 : ((uint) 1 << (count * 2)) - 1;
+}
+
+/**
+ * Копирует count тритов, не пересекающих границу слова назначения.
+ * Слова источника, не содержащие копируемых тритов, не читаются.
+ */
+inline void tritWordsCopyPart(const uint* source, size_t sourcePos,
+                              uint* destination, size_t destinationPos, size_t count) {
+    size_t shift = sourcePos % TRITS_PER_WORD;
+    const uint* word = source + sourcePos / TRITS_PER_WORD;
+    
+    uint bits = word[0] >> (shift * 2);
+    if (shift + count > TRITS_PER_WORD)
+        bits |= word[1] << ((TRITS_PER_WORD - shift) * 2);
+    
+    uint mask = tritWordLowMask(count) << (destinationPos % TRITS_PER_WORD * 2);
+    uint& result = destination[destinationPos / TRITS_PER_WORD];
+    result = (result & ~mask) | ((bits << (destinationPos % TRITS_PER_WORD * 2)) & mask);
+}
+
+/**
+ * Копирует count тритов с позиции sourcePos на позицию destinationPos.
+ * Как memmove, допускает пересечение областей (в том числе в одном хранилище).
+ * При одинаковом смещении внутри слова целые слова копируются memmove,
+ * иначе каждое слово назначения склеивается из двух слов источника.
+ */
+inline void tritWordsCopy(const uint* source, size_t sourcePos,
+                          uint* destination, size_t destinationPos, size_t count) {
+    if (!count)
+        return;
+    
+    // Части копирования выровнены по словам назначения
+    size_t head = TRITS_PER_WORD - destinationPos % TRITS_PER_WORD;
+    if (head > count)
+        head = count;
+    size_t tail = (count - head) % TRITS_PER_WORD;
+    size_t middle = count - head - tail;
+    
+    bool backward = destination == source && destinationPos > sourcePos;
+    bool aligned = sourcePos % TRITS_PER_WORD == destinationPos % TRITS_PER_WORD;
+    
+    if (backward && tail)
+        tritWordsCopyPart(source, sourcePos + head + middle,
+                          destination, destinationPos + head + middle, tail);
+    else if (!backward)
+        tritWordsCopyPart(source, sourcePos, destination, destinationPos, head);
+    
+    if (aligned) {
+        std::memmove(destination + (destinationPos + head) / TRITS_PER_WORD,
+                     source + (sourcePos + head) / TRITS_PER_WORD,
+                     middle / TRITS_PER_WORD * sizeof(uint));
+    } else if (backward) {
+        for (size_t offset = head + middle; offset > head; offset -= TRITS_PER_WORD)
+            tritWordsCopyPart(source, sourcePos + offset - TRITS_PER_WORD, destination,
+                              destinationPos + offset - TRITS_PER_WORD, TRITS_PER_WORD);
+    } else {
+        for (size_t offset = head; offset < head + middle; offset += TRITS_PER_WORD)
+            tritWordsCopyPart(source, sourcePos + offset,
+                              destination, destinationPos + offset, TRITS_PER_WORD);
+    }
+    
+    if (backward)
+        tritWordsCopyPart(source, sourcePos, destination, destinationPos, head);
+    else if (tail)
+        tritWordsCopyPart(source, sourcePos + head + middle,
+                          destination, destinationPos + head + middle, tail);
+}
+
+/**
+ * Сбрасывает count тритов с позиции pos в Unknown.
+ */
+inline void tritWordsClear(uint* words, size_t pos, size_t count) {
+    while (count) {
+        size_t part = TRITS_PER_WORD - pos % TRITS_PER_WORD;
+        if (part > count)
+            part = count;
+        
+        words[pos / TRITS_PER_WORD] &= ~(tritWordLowMask(part) << (pos % TRITS_PER_WORD * 2));
+        pos += part;
+        count -= part;
+    }
+}
+
+#endif /* TritWord_h */
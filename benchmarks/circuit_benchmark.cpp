@@ -0,0 +1,139 @@
+//
+//  circuit_benchmark.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+//  Сравнение моделирования схемы по словам с вычислением
+//  каждого элемента отдельно для каждого вектора.
+//  Аргументы: кол-во элементов, кол-во входов, кол-во векторов, кол-во потоков.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "../TritCircuit.h"
+#include "../TritSetBuilder.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * Элемент сгенерированной схемы.
+ */
+struct GeneratedGate {
+    TritGateType type;
+    std::vector<size_t> inputs;
+};
+
+/**
+ * Схема из двухвходовых элементов, входы которых берутся из недавних
+ * сигналов, как у синтезированной логики с локальными связями.
+ */
+static std::vector<GeneratedGate> generateNetlist(std::mt19937& random, size_t gates, size_t inputs) {
+    const TritGateType types[] = {GateAnd, GateOr, GateNand, GateNor, GateXor, GateNot};
+    std::vector<GeneratedGate> netlist;
+    
+    for (size_t i = 0; i < gates; i++) {
+        size_t signals = inputs + i;
+        size_t window = signals < 256 ? signals : 256;
+        
+        GeneratedGate gate = {types[random() % 6], {}};
+        size_t count = gate.type == GateNot ? 1 : 2;
+        for (size_t j = 0; j < count; j++)
+            gate.inputs.push_back(signals - 1 - random() % window);
+        
+        netlist.push_back(gate);
+    }
+    
+    return netlist;
+}
+
+/**
+ * Значение элемента для одного вектора через скалярные операции Trit.
+ */
+static Trit evaluate(const GeneratedGate& gate, const std::vector<Trit>& signals) {
+    Trit left = signals[gate.inputs[0]];
+    
+    switch (gate.type) {
+        case GateNot:
+            return ~left;
+        case GateAnd:
+            return left & signals[gate.inputs[1]];
+        case GateOr:
+            return left | signals[gate.inputs[1]];
+        case GateNand:
+            return ~(left & signals[gate.inputs[1]]);
+        case GateNor:
+            return ~(left | signals[gate.inputs[1]]);
+        default:
+            return left ^ signals[gate.inputs[1]];
+    }
+}
+
+int main(int argc, const char * argv[]) {
+    size_t gates = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t inputsCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 128;
+    size_t vectors = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 65536;
+    size_t threads = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 1;
+    
+    std::mt19937 random(42);
+    std::vector<GeneratedGate> netlist = generateNetlist(random, gates, inputsCount);
+    
+    TritCircuit circuit;
+    for (size_t i = 0; i < inputsCount; i++)
+        circuit.addInput();
+    for (const GeneratedGate& gate : netlist)
+        circuit.addGate(gate.type, gate.inputs);
+    
+    // Выходы - последние элементы, как у выходов конвейера
+    std::vector<size_t> outputs;
+    for (size_t i = 0; i < 64 && i < gates; i++) {
+        outputs.push_back(inputsCount + gates - 1 - i);
+        circuit.addOutput(outputs.back());
+    }
+    
+    std::vector<TritSet> inputs;
+    for (size_t i = 0; i < inputsCount; i++) {
+        TritSetBuilder builder(vectors);
+        for (size_t j = 0; j < vectors; j++)
+            builder.append(random() % 8 ? Trit(random() % 2 * 2) : Unknown);
+        inputs.push_back(builder.build());
+    }
+    
+    Clock::time_point start = Clock::now();
+    std::vector<TritSet> results = circuit.simulate(inputs, threads);
+    double circuitTime = millisecondsSince(start);
+    
+    std::printf("netlist: %zu gates, %zu inputs, depth %zu\n", gates, inputsCount, circuit.depth());
+    std::printf("circuit: %zu vectors in %.1f ms, %.3f ns per gate-vector\n",
+                vectors, circuitTime, circuitTime * 1e6 / gates / vectors);
+    
+    // Скалярное вычисление слишком медленное для всех векторов: берем выборку
+    size_t sample = vectors < 1024 ? vectors : 1024;
+    size_t mismatches = 0;
+    std::vector<Trit> signals(inputsCount + gates);
+    
+    start = Clock::now();
+    for (size_t vector = 0; vector < sample; vector++) {
+        for (size_t i = 0; i < inputsCount; i++)
+            signals[i] = inputs[i][vector];
+        for (size_t i = 0; i < gates; i++)
+            signals[inputsCount + i] = evaluate(netlist[i], signals);
+        
+        for (size_t i = 0; i < outputs.size(); i++)
+            if (signals[outputs[i]] != results[i][vector])
+                mismatches++;
+    }
+    double scalarTime = millisecondsSince(start);
+    
+    std::printf("scalar: %zu vectors in %.1f ms, %.3f ns per gate-vector, mismatches %zu\n",
+                sample, scalarTime, scalarTime * 1e6 / gates / sample, mismatches);
+    return mismatches ? 1 : 0;
+}
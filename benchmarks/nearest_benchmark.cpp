@@ -0,0 +1,99 @@
+//
+//  nearest_benchmark.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+//  Сравнение индекса ближайших соседей с полным перебором.
+//  Аргументы: кол-во наборов, размер набора, кол-во запросов, k.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "../TritDistance.h"
+#include "../TritNearestIndex.h"
+#include "../TritSetBuilder.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * Случайные центры групп похожих наборов.
+ */
+static std::vector<TritSet> generateCenters(std::mt19937& random, size_t count, size_t size) {
+    std::vector<TritSet> centers;
+    for (size_t i = 0; i < count; i++) {
+        TritSetBuilder builder(size);
+        for (size_t j = 0; j < size; j++)
+            builder.append(Trit(random() % 3));
+        centers.push_back(builder.build());
+    }
+    return centers;
+}
+
+/**
+ * Наборы-отпечатки: мутации центров, как у похожих объектов в реальных данных.
+ */
+static std::vector<TritSet> generateSets(std::mt19937& random, const std::vector<TritSet>& centers,
+                                         size_t count, size_t size) {
+    std::vector<TritSet> sets;
+    sets.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        TritSetBuilder builder(centers[random() % centers.size()]);
+        for (size_t j = random() % (size / 8 + 1); j > 0; j--)
+            builder.set(random() % size, Trit(random() % 3));
+        sets.push_back(builder.build());
+    }
+    
+    return sets;
+}
+
+int main(int argc, const char * argv[]) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t size = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 256;
+    size_t queries = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 100;
+    size_t k = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 10;
+    
+    std::mt19937 random(42);
+    std::vector<TritSet> centers = generateCenters(random, 64, size);
+    std::vector<TritSet> sets = generateSets(random, centers, count, size);
+    std::vector<TritSet> queriesSets = generateSets(random, centers, queries, size);
+    
+    Clock::time_point start = Clock::now();
+    TritNearestIndex index(sets);
+    std::printf("build: %zu sets of %zu trits in %.1f ms\n", count, size, millisecondsSince(start));
+    
+    std::vector<const TritSet*> pointers;
+    for (const TritSet& set : sets)
+        pointers.push_back(&set);
+    
+    double indexTime = 0, bruteTime = 0;
+    size_t mismatches = 0;
+    
+    for (const TritSet& query : queriesSets) {
+        start = Clock::now();
+        std::vector<TritNeighbor> nearest = index.nearest(query, k);
+        indexTime += millisecondsSince(start);
+        
+        start = Clock::now();
+        std::vector<size_t> distances = tritDistances(query, pointers.data(), pointers.size());
+        std::vector<size_t> sorted = distances;
+        std::nth_element(sorted.begin(), sorted.begin() + (k - 1), sorted.end());
+        bruteTime += millisecondsSince(start);
+        
+        if (nearest.size() != k || nearest.back().distance != sorted[k - 1])
+            mismatches++;
+    }
+    
+    std::printf("k-NN (k = %zu): index %.3f ms/query, brute force %.3f ms/query, mismatches %zu\n",
+                k, indexTime / queries, bruteTime / queries, mismatches);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+//
+//  apply_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "test_sets.h"
+#include "TritApply.h"
+
+typedef TritTruthTable<False, False, False, False, Unknown, Unknown, False, Unknown, True> AndTable;
+typedef TritTruthTable<False, Unknown, True, Unknown, Unknown, True, True, True, True> OrTable;
+typedef TritTruthTable<False, Unknown, True, Unknown, Unknown, Unknown, True, Unknown, False> XorTable;
+typedef TritTruthTable<True, True, True, Unknown, True, True, False, Unknown, True> LukasiewiczTable;
+typedef TritTruthTable<True, True, True, True, True, True, True, True, True> TrueTable;
+typedef TritTruthTable<False, False, False, Unknown, Unknown, Unknown, True, True, True> LeftTable;
+
+static_assert(TritWordBinary<AndTable>::apply(0b1001, 0b0110) == tritWordAnd(0b1001, 0b0110),
+              "Compile time AND");
+
+/**
+ * Проверяет результат по таблице истинности для каждого трита.
+ */
+template <typename Table>
+static void checkTable(const TritSet& left, const TritSet& right) {
+    TritSet result = applyBinary<Table>(left, right);
+    
+    Trit table[3][3];
+    for (size_t i = 0; i < 3; i++)
+        for (size_t j = 0; j < 3; j++)
+            table[i][j] = Table::value(Trit(i), Trit(j));
+    
+    ASSERT_EQ(applyBinary(left, right, table), result);
+    
+    size_t tritsCount = std::max(left.size(), right.size());
+    for (size_t i = 0; i < tritsCount + 20; i++)
+        ASSERT_EQ(result.getTrit(i), i < tritsCount
+                  ? Table::value(left.getTrit(i), right.getTrit(i)) : Unknown);
+}
+
+TEST(ApplyBinaryTest, BuiltinOperators) {
+    std::srand(1);
+    TritSet left = randomSet(300), right = randomSet(170);
+    
+    ASSERT_EQ(applyBinary<AndTable>(left, right), left & right);
+    ASSERT_EQ(applyBinary<OrTable>(left, right), left | right);
+    ASSERT_EQ(applyBinary<XorTable>(left, right), left ^ right);
+}
+
+TEST(ApplyBinaryTest, MatchesTable) {
+    std::srand(2);
+    TritSet left = randomSet(250), right = randomSet(333);
+    
+    checkTable<AndTable>(left, right);
+    checkTable<LukasiewiczTable>(left, right);
+    checkTable<TrueTable>(left, right);
+    checkTable<LeftTable>(right, left);
+    checkTable<TrueTable>(TritSet(), TritSet());
+}
+
+TEST(ApplyBinaryTest, RandomTables) {
+    std::srand(3);
+    TritSet left = randomSet(200), right = randomSet(200);
+    
+    for (size_t iteration = 0; iteration < 100; iteration++) {
+        Trit table[3][3];
+        for (size_t i = 0; i < 3; i++)
+            for (size_t j = 0; j < 3; j++)
+                table[i][j] = Trit(std::rand() % 3);
+        
+        TritSet result = applyBinary(left, right, table);
+        for (size_t i = 0; i < std::max(left.size(), right.size()); i++)
+            ASSERT_EQ(result.getTrit(i), table[left.getTrit(i)][right.getTrit(i)]);
+    }
+}
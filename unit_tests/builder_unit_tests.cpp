@@ -0,0 +1,112 @@
+//
+//  builder_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "TritSetBuilder.h"
+
+TEST(TritSetBuilderTest, Empty) {
+    TritSetBuilder builder(100);
+    
+    ASSERT_EQ(builder.size(), 0);
+    
+    TritSet set = builder.build();
+    ASSERT_EQ(set.size(), 0);
+    ASSERT_EQ(set, TritSet());
+}
+
+TEST(TritSetBuilderTest, AppendMatchesSetTrit) {
+    TritSetBuilder builder;
+    TritSet expected;
+    std::srand(1);
+    
+    for (size_t i = 0; i < 1000; i++) {
+        Trit trit = Trit(std::rand() % 3);
+        builder.append(trit);
+        expected.setTrit(i, trit);
+    }
+    
+    ASSERT_EQ(builder.size(), 1000);
+    
+    TritSet set = builder.build();
+    ASSERT_EQ(set, expected);
+    ASSERT_EQ(set.size(), expected.size());
+    ASSERT_EQ(builder.size(), 0);
+}
+
+TEST(TritSetBuilderTest, ScatteredWrites) {
+    TritSetBuilder builder(10);
+    TritSet expected;
+    std::srand(2);
+    
+    for (size_t i = 0; i < 500; i++) {
+        size_t pos = std::rand() % 300;
+        Trit trit = Trit(std::rand() % 3);
+        builder.set(pos, trit);
+        expected.setTrit(pos, trit);
+    }
+    
+    // Перезапись значением Unknown на последней позиции
+    builder.set(299, Unknown);
+    expected.setTrit(299, Unknown);
+    
+    TritSet set = builder.build();
+    ASSERT_EQ(set, expected);
+    ASSERT_EQ(set.size(), expected.size());
+}
+
+TEST(TritSetBuilderTest, Words) {
+    TritSet source(100);
+    std::srand(3);
+    for (size_t i = 0; i < 100; i++)
+        source[i] = Trit(std::rand() % 3);
+    
+    TritSetBuilder builder;
+    builder.setWord(1, source.words()[1]).setWord(0, source.words()[0]);
+    ASSERT_EQ(builder.size(), 32);
+    
+    builder.appendWord(source.words()[2], 5);
+    for (size_t pos = 37; pos < 100; pos += 7)
+        builder.appendWord(source.words()[pos / 16] >> (pos % 16 * 2)
+                           | (pos % 16 > 9 ? source.words()[pos / 16 + 1] << ((16 - pos % 16) * 2) : 0), 7);
+    
+    TritSet set = builder.build();
+    ASSERT_EQ(set, TritSet(source).trim(100));
+}
+
+TEST(TritSetBuilderTest, ContinueExisting) {
+    TritSet set(20, True);
+    TritSetBuilder builder(set);
+    
+    ASSERT_EQ(builder.size(), 20);
+    builder.append(False).set(0, Unknown);
+    
+    set.setTrit(20, False).setTrit(0, Unknown);
+    ASSERT_EQ(builder.build(), set);
+}
+
+TEST(TritSetBuilderTest, NoTrailingWords) {
+    TritSetBuilder builder(10000);
+    for (size_t i = 0; i < 1000; i++)
+        builder.append(True);
+    builder.set(1500, False);
+    builder.setWord(70, 0);
+    
+    // Ни запас памяти, ни рост при записи не попадают в набор
+    TritSet set = builder.build();
+    ASSERT_EQ(set.size(), 1501);
+    ASSERT_EQ(set.words().size(), 94);
+    
+    TritSet source(5000, True);
+    source.setTrit(4000, Unknown);
+    source.setTrit(4999, Unknown);
+    TritSet continued = TritSetBuilder(source).build();
+    ASSERT_EQ(continued, source);
+    ASSERT_EQ(continued.words().size(), continued.size() / 16 + 1);
+}
@@ -0,0 +1,142 @@
+//
+//  circuit_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "TritCircuit.h"
+#include "TritSetBuilder.h"
+
+/**
+ * Значение элемента для одного вектора через скалярные операции.
+ */
+static Trit evaluate(TritGateType type, const std::vector<Trit>& inputs) {
+    Trit result = inputs[0];
+    for (size_t i = 1; i < inputs.size(); i++) {
+        if (type == GateAnd || type == GateNand)
+            result = result & inputs[i];
+        else if (type == GateOr || type == GateNor)
+            result = result | inputs[i];
+        else
+            result = result ^ inputs[i];
+    }
+    
+    bool invert = type == GateNot || type == GateNand || type == GateNor || type == GateXnor;
+    return invert ? ~result : result;
+}
+
+TEST(Circuit, HalfAdder) {
+    TritCircuit circuit;
+    size_t a = circuit.addInput();
+    size_t b = circuit.addInput();
+    
+    // Вход элемента ссылается на сигналы, добавленные позже
+    size_t sum = circuit.addGate(GateOr, {circuit.signalsCount() + 2, circuit.signalsCount() + 4});
+    size_t notB = circuit.addGate(GateNot, {b});
+    circuit.addGate(GateAnd, {a, notB});
+    size_t notA = circuit.addGate(GateNot, {a});
+    circuit.addGate(GateAnd, {notA, b});
+    size_t carry = circuit.addGate(GateAnd, {a, b});
+    circuit.addOutput(sum);
+    circuit.addOutput(carry);
+    
+    ASSERT_EQ(3, circuit.depth());
+    
+    TritSet first(9), second(9);
+    const Trit values[] = {False, Unknown, True};
+    for (size_t i = 0; i < 9; i++) {
+        first[i] = values[i / 3];
+        second[i] = values[i % 3];
+    }
+    
+    std::vector<TritSet> result = circuit.simulate({first, second});
+    ASSERT_EQ(2, result.size());
+    
+    for (size_t i = 0; i < 9; i++) {
+        ASSERT_EQ(first[i] & second[i], result[1][i]);
+        ASSERT_EQ((first[i] & ~second[i]) | (~first[i] & second[i]), result[0][i]);
+    }
+    
+    ASSERT_THROW(circuit.simulate({first}), std::invalid_argument);
+    ASSERT_THROW(circuit.addGate(GateNot, {a, b}), std::invalid_argument);
+    ASSERT_THROW(circuit.addGate(GateAnd, {}), std::invalid_argument);
+    
+    // Петля через два элемента
+    size_t loop = circuit.addGate(GateAnd, {a, circuit.signalsCount() + 1});
+    circuit.addGate(GateOr, {loop, b});
+    ASSERT_THROW(circuit.depth(), std::runtime_error);
+}
+
+TEST(Circuit, Random) {
+    TritCircuit circuit;
+    std::vector<TritGateType> types;
+    std::vector<std::vector<size_t>> gateInputs;
+    std::vector<size_t> outputs;
+    
+    for (size_t i = 0; i < 10; i++) {
+        circuit.addInput();
+        types.push_back(GateBuffer);
+        gateInputs.push_back({});
+    }
+    
+    for (size_t i = 0; i < 300; i++) {
+        TritGateType type = TritGateType(std::rand() % 8);
+        size_t count = type == GateBuffer || type == GateNot ? 1 : 2 + std::rand() % 3;
+        
+        std::vector<size_t> inputs;
+        for (size_t j = 0; j < count; j++)
+            inputs.push_back(std::rand() % circuit.signalsCount());
+        
+        circuit.addGate(type, inputs);
+        types.push_back(type);
+        gateInputs.push_back(inputs);
+        
+        if (std::rand() % 20 == 0)
+            outputs.push_back(circuit.signalsCount() - 1);
+    }
+    outputs.push_back(3);
+    outputs.push_back(circuit.signalsCount() - 1);
+    
+    for (size_t signal : outputs)
+        circuit.addOutput(signal);
+    
+    // Векторов больше одного блока моделирования
+    std::vector<TritSet> inputs;
+    for (size_t i = 0; i < 10; i++) {
+        TritSetBuilder builder(3000);
+        for (size_t j = 3000 - std::rand() % 100; j > 0; j--)
+            builder.append(Trit(std::rand() % 3));
+        inputs.push_back(builder.build());
+    }
+    
+    std::vector<TritSet> single = circuit.simulate(inputs);
+    std::vector<TritSet> parallel = circuit.simulate(inputs, 3);
+    ASSERT_EQ(circuit.outputsCount(), single.size());
+    
+    for (size_t vector = 0; vector < 3000; vector += 7) {
+        std::vector<Trit> signals;
+        for (size_t i = 0; i < types.size(); i++) {
+            if (i < 10) {
+                signals.push_back(inputs[i][vector]);
+                continue;
+            }
+            
+            std::vector<Trit> values;
+            for (size_t input : gateInputs[i])
+                values.push_back(signals[input]);
+            signals.push_back(evaluate(types[i], values));
+        }
+        
+        for (size_t i = 0; i < outputs.size(); i++)
+            ASSERT_EQ(signals[outputs[i]], single[i][vector]);
+    }
+    
+    for (size_t i = 0; i < single.size(); i++)
+        ASSERT_TRUE(single[i] == parallel[i]);
+}
@@ -0,0 +1,99 @@
+//
+//  codec_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "TritCodec.h"
+
+/**
+ * Набор тритов с длинными сериями Unknown и случайными участками.
+ */
+static TritSet sparseSet(size_t count) {
+    TritSet set(count);
+    std::srand(42);
+    
+    for (size_t i = 0; i < count; i++)
+        if ((i / 1000) % 3 == 0)
+            set[i] = Trit(std::rand() % 3);
+        else if ((i / 1000) % 3 == 1)
+            set[i] = True;
+    
+    set[count - 1] = False;
+    return set;
+}
+
+TEST(CodecTritSetTest, EmptyRoundTrip) {
+    TritSet set;
+    std::vector<uint8_t> data = tritSetCompress(set);
+    
+    ASSERT_EQ(tritSetDecompress(data.data(), data.size()), set);
+    ASSERT_EQ(CompressedTritSet(data.data(), data.size()).blocksCount(), 0);
+}
+
+TEST(CodecTritSetTest, RoundTrip) {
+    TritSet set = sparseSet(100000);
+    std::vector<uint8_t> data = tritSetCompress(set, 4096);
+    
+    ASSERT_LT(data.size(), set.serializedSize());
+    
+    TritSet result = tritSetDecompress(data.data(), data.size());
+    ASSERT_EQ(result.size(), set.size());
+    ASSERT_EQ(result, set);
+}
+
+TEST(CodecTritSetTest, ShortRuns) {
+    TritSet* sets[] = {new TritSet(1, False), new TritSet(17, True), new TritSet(300, False)};
+    (*sets[2])[5] = Unknown;
+    (*sets[2])[150] = True;
+    
+    for (TritSet* set : sets) {
+        std::vector<uint8_t> data = tritSetCompress(*set, 16);
+        ASSERT_EQ(tritSetDecompress(data.data(), data.size()), (*set));
+        delete set;
+    }
+}
+
+TEST(CodecTritSetTest, RandomAccessBlock) {
+    TritSet set = sparseSet(10000);
+    std::vector<uint8_t> data = tritSetCompress(set, 1000);
+    CompressedTritSet compressed(data.data(), data.size());
+    
+    ASSERT_EQ(compressed.size(), set.size());
+    ASSERT_EQ(compressed.blockTrits(), 1008);
+    ASSERT_EQ(compressed.blocksCount(), 10);
+    
+    for (size_t i = 0; i < compressed.blocksCount(); i++) {
+        TritSet block = compressed.block(i);
+        for (size_t j = 0; j < compressed.blockTrits(); j++)
+            ASSERT_EQ(block[j], set[i * compressed.blockTrits() + j]);
+    }
+    
+    ASSERT_THROW(compressed.block(compressed.blocksCount()), std::out_of_range);
+    ASSERT_THROW(tritSetCompress(set, (size_t) UINT32_MAX + 1), std::invalid_argument);
+}
+
+TEST(CodecTritSetTest, ParallelDecompress) {
+    TritSet set = sparseSet(200000);
+    std::vector<uint8_t> data = tritSetCompress(set, 4096);
+    
+    ASSERT_EQ(tritSetDecompress(data.data(), data.size(), 4), set);
+    ASSERT_EQ(tritSetDecompress(data.data(), data.size(), 0), set);
+}
+
+TEST(CodecTritSetTest, CorruptedData) {
+    TritSet set = sparseSet(5000);
+    std::vector<uint8_t> data = tritSetCompress(set, 1024);
+    
+    ASSERT_THROW(tritSetDecompress(data.data(), 10), std::runtime_error);
+    ASSERT_THROW(tritSetDecompress(data.data(), data.size() - 1), std::runtime_error);
+    
+    data.back() = 0xFF;
+    ASSERT_THROW(tritSetDecompress(data.data(), data.size(), 2), std::runtime_error);
+}
@@ -0,0 +1,126 @@
+//
+//  convert_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include "gtest/gtest.h"
+#include "test_sets.h"
+#include "TritConvert.h"
+
+TEST(ConvertTest, Int8RoundTrip) {
+    for (size_t count : {0, 1, 15, 16, 17, 1000}) {
+        TritSet set = randomSet(count, (unsigned) count);
+        std::vector<int8_t> values(count + 5, 7);
+        
+        tritSetToInt8(set, values.data(), count);
+        for (size_t i = 0; i < count; i++)
+            ASSERT_EQ(values[i], set.getTrit(i) == False ? -1 : (set.getTrit(i) == True ? 1 : 0));
+        ASSERT_EQ(values[count], 7);
+        
+        TritSet result = tritSetFromInt8(values.data(), count);
+        ASSERT_EQ(result, set);
+        ASSERT_EQ(result.size(), set.size());
+    }
+}
+
+TEST(ConvertTest, Int8Signs) {
+    const int8_t values[] = {-128, -5, 0, 3, 127, 0, -1, 1};
+    TritSet set = tritSetFromInt8(values, sizeof(values));
+    
+    const Trit expected[] = {False, False, Unknown, True, True, Unknown, False, True};
+    for (size_t i = 0; i < sizeof(values); i++)
+        ASSERT_EQ(set.getTrit(i), expected[i]);
+}
+
+TEST(ConvertTest, Int8PastEnd) {
+    TritSet set(10, True);
+    std::vector<int8_t> values(40, 7);
+    
+    tritSetToInt8(set, values.data(), values.size());
+    for (size_t i = 0; i < values.size(); i++)
+        ASSERT_EQ(values[i], i < 10 ? 1 : 0);
+}
+
+TEST(ConvertTest, BytesRoundTrip) {
+    TritSet set = randomSet(333, 1);
+    std::vector<uint8_t> codes(333);
+    
+    tritSetToBytes(set, codes.data(), codes.size());
+    for (size_t i = 0; i < codes.size(); i++)
+        ASSERT_EQ(codes[i], set.getTrit(i));
+    
+    ASSERT_EQ(tritSetFromBytes(codes.data(), codes.size()), set);
+    
+    // Недопустимые значения считаются Unknown
+    codes[5] = 200;
+    ASSERT_EQ(tritSetFromBytes(codes.data(), codes.size()).getTrit(5), Unknown);
+}
+
+TEST(ConvertTest, TritsRoundTrip) {
+    for (size_t count : {1, 15, 16, 17, 100}) {
+        TritSet set = randomSet(count, (unsigned) count);
+        std::vector<Trit> trits = tritSetToTrits(set);
+        
+        ASSERT_EQ(trits.size(), set.size());
+        for (size_t i = 0; i < trits.size(); i++)
+            ASSERT_EQ(trits[i], set.getTrit(i));
+        
+        ASSERT_EQ(tritSetFromTrits(trits), set);
+    }
+    
+    ASSERT_EQ(tritSetFromTrits(std::vector<Trit>()).size(), 0);
+    ASSERT_EQ(tritSetToTrits(TritSet()).size(), 0);
+    ASSERT_EQ(tritSetFromTrits(std::vector<Trit>(20, Unknown)).size(), 0);
+}
+
+TEST(ConvertTest, MasksRoundTrip) {
+    for (size_t count : {0, 1, 16, 63, 64, 65, 1000}) {
+        TritSet set = randomSet(count, (unsigned) count + 10);
+        std::vector<uint64_t> known((count + 63) / 64 + 1, 0xFF), value((count + 63) / 64 + 1, 0xFF);
+        
+        tritSetToMasks(set, known.data(), value.data(), count);
+        for (size_t i = 0; i < count; i++) {
+            ASSERT_EQ((known[i / 64] >> (i % 64)) & 1, set.getTrit(i) != Unknown);
+            ASSERT_EQ((value[i / 64] >> (i % 64)) & 1, set.getTrit(i) == True);
+        }
+        if (count % 64) {
+            ASSERT_EQ(known[count / 64] >> (count % 64), 0);
+        }
+        ASSERT_EQ(known.back(), 0xFF);
+        
+        ASSERT_EQ(tritSetFromMasks(known.data(), value.data(), count), set);
+    }
+}
+
+TEST(ConvertTest, MasksIgnoreUnknownValue) {
+    const uint64_t known = 0b0011, value = 0b1110;
+    TritSet set = tritSetFromMasks(&known, &value, 40);
+    
+    ASSERT_EQ(set.size(), 2);
+    ASSERT_EQ(set.getTrit(0), False);
+    ASSERT_EQ(set.getTrit(1), True);
+    ASSERT_EQ(set.getTrit(2), Unknown);
+}
+
+TEST(ConvertTest, Bitset) {
+    TritSet set = randomSet(150, 3);
+    std::bitset<150> known, value;
+    
+    tritSetToMasks(set, known, value);
+    for (size_t i = 0; i < 150; i++) {
+        ASSERT_EQ(known[i], set.getTrit(i) != Unknown);
+        ASSERT_EQ(value[i], set.getTrit(i) == True);
+    }
+    
+    ASSERT_EQ(tritSetFromMasks(known, value), set);
+    
+    std::bitset<5> smallKnown("10101"), smallValue("00100");
+    TritSet small = tritSetFromMasks(smallKnown, smallValue);
+    ASSERT_EQ(small.getTrit(0), False);
+    ASSERT_EQ(small.getTrit(2), True);
+    ASSERT_EQ(small.getTrit(4), False);
+    ASSERT_EQ(small.size(), 5);
+}
@@ -0,0 +1,211 @@
+//
+//  dataset_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "TritDataset.h"
+
+static const char* DATASET_TEST_FILE = "dataset_unit_test.trds";
+
+/**
+ * Набор тритов, зависящий от номера: True на позициях, кратных seed,
+ * False на остальных четных позициях.
+ */
+static TritSet numberedSet(size_t seed) {
+    TritSet set(seed * 7);
+    for (size_t i = 0; i < seed * 7; i += 2)
+        set[i] = i % (seed + 1) ? False : True;
+    return set;
+}
+
+TEST(DatasetTest, WriteAndRead) {
+    std::remove(DATASET_TEST_FILE);
+    
+    {
+        TritDatasetWriter writer(DATASET_TEST_FILE);
+        for (size_t i = 0; i < 50; i++)
+            ASSERT_EQ(writer.append(numberedSet(i)), i);
+        ASSERT_EQ(writer.size(), 50);
+    }
+    
+    TritDataset dataset(DATASET_TEST_FILE);
+    ASSERT_EQ(dataset.size(), 50);
+    
+    for (size_t i = 0; i < 50; i++) {
+        TritSet expected = numberedSet(i);
+        MappedTritSet set = dataset[i];
+        
+        ASSERT_EQ(dataset.tritsCount(i), expected.size());
+        ASSERT_EQ(set.size(), expected.size());
+        ASSERT_TRUE(set.verify());
+        ASSERT_EQ(set.toTritSet(), expected);
+        
+        ASSERT_EQ(dataset.cardinality(i, False), expected.cardinality(False));
+        ASSERT_EQ(dataset.cardinality(i, Unknown), expected.cardinality(Unknown));
+        ASSERT_EQ(dataset.cardinality(i, True), expected.cardinality(True));
+    }
+    
+    ASSERT_THROW(dataset[50], std::out_of_range);
+    
+    std::remove(DATASET_TEST_FILE);
+}
+
+TEST(DatasetTest, AppendToExisting) {
+    std::remove(DATASET_TEST_FILE);
+    
+    for (size_t round = 0; round < 3; round++) {
+        TritDatasetWriter writer(DATASET_TEST_FILE);
+        ASSERT_EQ(writer.size(), round * 5);
+        for (size_t i = 0; i < 5; i++)
+            writer.append(numberedSet(round * 5 + i));
+    }
+    
+    TritDataset dataset(DATASET_TEST_FILE);
+    ASSERT_EQ(dataset.size(), 15);
+    
+    for (size_t i = 0; i < 15; i++)
+        ASSERT_EQ(dataset[i].toTritSet(), numberedSet(i));
+    
+    std::remove(DATASET_TEST_FILE);
+}
+
+TEST(DatasetTest, AppendKeepsPreviousState) {
+    std::remove(DATASET_TEST_FILE);
+    
+    {
+        TritDatasetWriter writer(DATASET_TEST_FILE);
+        for (size_t i = 0; i < 5; i++)
+            writer.append(numberedSet(i + 10));
+    }
+    
+    {
+        // Пока новый заголовок не записан, файл читается в прежнем состоянии
+        TritDatasetWriter writer(DATASET_TEST_FILE);
+        for (size_t i = 0; i < 20; i++)
+            writer.append(numberedSet(i + 500));
+        
+        TritDataset dataset(DATASET_TEST_FILE);
+        ASSERT_EQ(dataset.size(), 5);
+        for (size_t i = 0; i < 5; i++)
+            ASSERT_EQ(dataset[i].toTritSet(), numberedSet(i + 10));
+    }
+    
+    TritDataset dataset(DATASET_TEST_FILE);
+    ASSERT_EQ(dataset.size(), 25);
+    for (size_t i = 0; i < 25; i++)
+        ASSERT_EQ(dataset[i].toTritSet(), numberedSet(i < 5 ? i + 10 : i + 495));
+    
+    std::remove(DATASET_TEST_FILE);
+}
+
+TEST(DatasetTest, EmptyDataset) {
+    std::remove(DATASET_TEST_FILE);
+    
+    TritDatasetWriter(DATASET_TEST_FILE).close();
+    
+    TritDataset dataset(DATASET_TEST_FILE);
+    ASSERT_EQ(dataset.size(), 0);
+    
+    std::remove(DATASET_TEST_FILE);
+}
+
+TEST(DatasetTest, OperatorsOnSets) {
+    std::remove(DATASET_TEST_FILE);
+    
+    {
+        TritDatasetWriter writer(DATASET_TEST_FILE);
+        writer.append(numberedSet(3));
+        writer.append(numberedSet(10));
+    }
+    
+    TritDataset dataset(DATASET_TEST_FILE);
+    
+    ASSERT_EQ(dataset[0] & dataset[1], numberedSet(3) & numberedSet(10));
+    ASSERT_EQ(dataset[0] | dataset[1], numberedSet(3) | numberedSet(10));
+    ASSERT_EQ(~dataset[1], ~numberedSet(10));
+    
+    std::remove(DATASET_TEST_FILE);
+}
+
+TEST(DatasetTest, CorruptedFile) {
+    MappedTritSet::write(TritSet(10, True), DATASET_TEST_FILE);
+    
+    ASSERT_THROW(TritDataset dataset(DATASET_TEST_FILE), std::runtime_error);
+    ASSERT_THROW(TritDatasetWriter writer(DATASET_TEST_FILE), std::runtime_error);
+    
+    std::remove(DATASET_TEST_FILE);
+}
+
+/**
+ * Перезаписывает 64-битное поле в файле по данному смещению.
+ */
+static void patchField(const char* path, long offset, uint64_t value) {
+    FILE* file = std::fopen(path, "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, offset, SEEK_SET);
+    std::fwrite(&value, sizeof(value), 1, file);
+    std::fclose(file);
+}
+
+TEST(DatasetTest, CorruptedEntry) {
+    std::remove(DATASET_TEST_FILE);
+    
+    {
+        TritDatasetWriter writer(DATASET_TEST_FILE);
+        writer.append(numberedSet(3));
+    }
+    
+    TritDatasetHeader header;
+    FILE* file = std::fopen(DATASET_TEST_FILE, "rb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fread(&header, sizeof(header), 1, file), 1);
+    std::fclose(file);
+    
+    long entry = (long) header.indexOffset;
+    
+    patchField(DATASET_TEST_FILE, entry + offsetof(TritDatasetEntry, trueCount), SIZE_MAX);
+    {
+        TritDataset dataset(DATASET_TEST_FILE);
+        ASSERT_THROW(dataset.cardinality(0, Unknown), std::runtime_error);
+        ASSERT_THROW(dataset[0], std::runtime_error);
+    }
+    
+    patchField(DATASET_TEST_FILE, entry + offsetof(TritDatasetEntry, tritsCount), SIZE_MAX);
+    {
+        TritDataset dataset(DATASET_TEST_FILE);
+        ASSERT_THROW(dataset.tritsCount(0), std::runtime_error);
+        ASSERT_THROW(dataset[0], std::runtime_error);
+    }
+    
+    std::remove(DATASET_TEST_FILE);
+}
+
+TEST(DatasetTest, ForeignByteOrder) {
+    std::remove(DATASET_TEST_FILE);
+    
+    {
+        TritDatasetWriter writer(DATASET_TEST_FILE);
+        writer.append(numberedSet(3));
+    }
+    
+    uint8_t foreign = tritNativeByteOrder() == TritLittleEndian ? TritBigEndian : TritLittleEndian;
+    FILE* file = std::fopen(DATASET_TEST_FILE, "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, offsetof(TritDatasetHeader, byteOrder), SEEK_SET);
+    std::fwrite(&foreign, sizeof(foreign), 1, file);
+    std::fclose(file);
+    
+    ASSERT_THROW(TritDataset dataset(DATASET_TEST_FILE), std::runtime_error);
+    ASSERT_THROW(TritDatasetWriter writer(DATASET_TEST_FILE), std::runtime_error);
+    
+    std::remove(DATASET_TEST_FILE);
+}
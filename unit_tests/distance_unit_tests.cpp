@@ -0,0 +1,84 @@
+//
+//  distance_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "test_sets.h"
+#include "TritDistance.h"
+
+static const char* DISTANCE_TEST_FILE = "distance_unit_test.trds";
+
+TEST(DistanceTest, MatchesScan) {
+    std::srand(1);
+    
+    for (size_t iteration = 0; iteration < 20; iteration++) {
+        TritSet left = randomSet(std::rand() % 300), right = randomSet(std::rand() % 300);
+        size_t size = std::max(left.size(), right.size());
+        size_t differences = 0, conflicts = 0, matches = 0, known = 0;
+        
+        for (size_t i = 0; i < size; i++) {
+            Trit a = left.getTrit(i), b = right.getTrit(i);
+            differences += a != b;
+            conflicts += (a ^ b) == True;
+            matches += a == b && a != Unknown;
+            known += a != Unknown || b != Unknown;
+        }
+        
+        ASSERT_EQ(tritDistance(left, right), differences);
+        ASSERT_EQ(tritDistance(right, left), differences);
+        ASSERT_EQ(tritConflicts(left, right), conflicts);
+        ASSERT_DOUBLE_EQ(tritJaccard(left, right), known ? (double) matches / known : 1.0);
+    }
+}
+
+TEST(DistanceTest, Identical) {
+    TritSet set(100, True);
+    set.setTrit(50, Unknown).setTrit(70, False);
+    
+    ASSERT_EQ(tritDistance(set, set), 0);
+    ASSERT_EQ(tritConflicts(set, ~set), 99);
+    ASSERT_EQ(tritDistance(set, TritSet()), 99);
+    ASSERT_DOUBLE_EQ(tritJaccard(set, set), 1.0);
+    ASSERT_DOUBLE_EQ(tritJaccard(TritSet(), TritSet()), 1.0);
+}
+
+TEST(DistanceTest, Batched) {
+    std::srand(2);
+    TritSet query = randomSet(500);
+    
+    std::vector<TritSet> sets;
+    std::vector<const TritSet*> pointers;
+    for (size_t i = 0; i < 30; i++)
+        sets.push_back(randomSet(std::rand() % 1000));
+    for (const TritSet& set : sets)
+        pointers.push_back(&set);
+    
+    std::vector<size_t> differences = tritDistances(query, pointers.data(), pointers.size());
+    std::vector<size_t> conflicts = tritDistances(query, pointers.data(), pointers.size(), TritConflicts);
+    
+    for (size_t i = 0; i < sets.size(); i++) {
+        ASSERT_EQ(differences[i], tritDistance(query, sets[i]));
+        ASSERT_EQ(conflicts[i], tritConflicts(query, sets[i]));
+    }
+    
+    std::remove(DISTANCE_TEST_FILE);
+    {
+        TritDatasetWriter writer(DISTANCE_TEST_FILE);
+        for (const TritSet& set : sets)
+            writer.append(set);
+    }
+    
+    TritDataset dataset(DISTANCE_TEST_FILE);
+    ASSERT_EQ(tritDistances(query, dataset), differences);
+    ASSERT_EQ(tritDistances(query, dataset, TritConflicts), conflicts);
+    
+    std::remove(DISTANCE_TEST_FILE);
+}
@@ -0,0 +1,135 @@
+//
+//  mapped_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "MappedTritSet.h"
+
+static const char* MAPPED_TEST_FILE = "mapped_unit_test.trit";
+
+/**
+ * Набор тритов с повторяющимся узором F, U, T, T, F.
+ */
+static TritSet patternSet(size_t count) {
+    const Trit pattern[] = {False, Unknown, True, True, False};
+    TritSet set(count);
+    for (size_t i = 0; i < count; i++)
+        set[i] = pattern[i % 5];
+    return set;
+}
+
+TEST(MappedTritSetTest, WriteAndOpen) {
+    TritSet set = patternSet(1000);
+    MappedTritSet::write(set, MAPPED_TEST_FILE);
+    
+    MappedTritSet mapped(MAPPED_TEST_FILE);
+    
+    ASSERT_EQ(mapped.size(), set.size());
+    ASSERT_TRUE(mapped.verify());
+    
+    for (size_t i = 0; i < 1010; i++)
+        ASSERT_EQ(mapped.getTrit(i), set.getTrit(i));
+    
+    ASSERT_EQ(mapped.toTritSet(), set);
+    
+    std::remove(MAPPED_TEST_FILE);
+}
+
+TEST(MappedTritSetTest, Empty) {
+    TritSet set;
+    MappedTritSet::write(set, MAPPED_TEST_FILE);
+    
+    MappedTritSet mapped(MAPPED_TEST_FILE);
+    
+    ASSERT_EQ(mapped.size(), 0);
+    ASSERT_EQ(mapped.getTrit(0), Unknown);
+    ASSERT_EQ(mapped.cardinality(Unknown), 0);
+    ASSERT_EQ(mapped.toTritSet(), set);
+    
+    std::remove(MAPPED_TEST_FILE);
+}
+
+TEST(MappedTritSetTest, Cardinality) {
+    TritSet set = patternSet(998);
+    MappedTritSet::write(set, MAPPED_TEST_FILE);
+    
+    MappedTritSet mapped(MAPPED_TEST_FILE);
+    
+    ASSERT_EQ(mapped.cardinality(False), set.cardinality(False));
+    ASSERT_EQ(mapped.cardinality(Unknown), set.cardinality(Unknown));
+    ASSERT_EQ(mapped.cardinality(True), set.cardinality(True));
+    
+    std::remove(MAPPED_TEST_FILE);
+}
+
+TEST(MappedTritSetTest, Operators) {
+    TritSet left = patternSet(300);
+    TritSet right = ~patternSet(200);
+    MappedTritSet::write(left, MAPPED_TEST_FILE);
+    
+    MappedTritSet mapped(MAPPED_TEST_FILE);
+    
+    ASSERT_EQ(~mapped, ~left);
+    ASSERT_EQ(mapped & right, left & right);
+    ASSERT_EQ(mapped | right, left | right);
+    ASSERT_EQ(mapped & mapped, left);
+    ASSERT_EQ(mapped | mapped, left);
+    
+    std::remove(MAPPED_TEST_FILE);
+}
+
+TEST(MappedTritSetTest, CorruptedFile) {
+    {
+        std::ofstream stream(MAPPED_TEST_FILE, std::ios::binary);
+        stream << "not a trit set at all, but long enough";
+    }
+    
+    ASSERT_THROW(MappedTritSet mapped(MAPPED_TEST_FILE), std::runtime_error);
+    
+    std::remove(MAPPED_TEST_FILE);
+    
+    ASSERT_THROW(MappedTritSet mapped(MAPPED_TEST_FILE), std::system_error);
+}
+
+TEST(MappedTritSetTest, HugeTritsCount) {
+    // Размер, при котором округление вверх до слов переполнилось бы в 0
+    TritFileHeader header = tritFileHeader(TritSet());
+    header.tritsCount = SIZE_MAX;
+    header.wordsCount = 0;
+    
+    uint8_t bytes[sizeof(TritFileHeader)];
+    tritFileHeaderEncode(header, bytes);
+    {
+        std::ofstream stream(MAPPED_TEST_FILE, std::ios::binary);
+        stream.write((const char*) bytes, sizeof(bytes));
+    }
+    
+    ASSERT_THROW(MappedTritSet mapped(MAPPED_TEST_FILE), std::runtime_error);
+    
+    std::remove(MAPPED_TEST_FILE);
+}
+
+TEST(MappedTritSetTest, ChecksumMismatch) {
+    MappedTritSet::write(patternSet(100), MAPPED_TEST_FILE);
+    
+    {
+        std::fstream stream(MAPPED_TEST_FILE, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(sizeof(TritFileHeader));
+        stream.put(0);
+    }
+    
+    MappedTritSet mapped(MAPPED_TEST_FILE);
+    ASSERT_FALSE(mapped.verify());
+    
+    std::remove(MAPPED_TEST_FILE);
+}
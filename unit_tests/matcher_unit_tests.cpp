@@ -0,0 +1,86 @@
+//
+//  matcher_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "TernaryMatcher.h"
+#include "TritSetBuilder.h"
+
+/**
+ * Правило из строки: F, T или U на каждой позиции.
+ */
+static TritSet rule(const char* pattern) {
+    TritSetBuilder builder;
+    for (; *pattern; pattern++)
+        builder.append(*pattern == 'F' ? False : (*pattern == 'T' ? True : Unknown));
+    return builder.build();
+}
+
+TEST(TernaryMatcher, Rules) {
+    std::vector<TritSet> rules = {rule("TTF"), rule("TU"), rule("UUUUUUUUUUUUUUUUUUF"), rule("")};
+    
+    for (TernaryIndex index : {TernaryScan, TernaryTupleSpace}) {
+        TernaryMatcher matcher(rules, index);
+        ASSERT_EQ(4, matcher.size());
+        
+        ASSERT_EQ(0, matcher.match(rule("TTF")));
+        ASSERT_EQ(1, matcher.match(rule("TTT")));
+        ASSERT_EQ(std::vector<size_t>({1, 3}), matcher.matchAll(rule("TFF")));
+        ASSERT_EQ(std::vector<size_t>({0, 1, 2, 3}), matcher.matchAll(rule("TTFFFFFFFFFFFFFFFFF")));
+        ASSERT_EQ(2, matcher.match(rule("FFFFFFFFFFFFFFFFFFF")));
+        
+        // Unknown в ключе не подходит под известный трит правила
+        ASSERT_EQ(3, matcher.match(rule("UT")));
+    }
+    
+    TernaryMatcher empty({});
+    ASSERT_EQ(TritSet::npos, empty.match(rule("T")));
+    ASSERT_TRUE(empty.matchAll(rule("T")).empty());
+}
+
+TEST(TernaryMatcher, Random) {
+    // Правила-префиксы разной длины, как в таблицах маршрутизации
+    std::vector<TritSet> rules;
+    for (size_t i = 0; i < 500; i++) {
+        TritSetBuilder builder(40);
+        size_t prefix = std::rand() % 41;
+        for (size_t j = 0; j < prefix; j++)
+            builder.append(std::rand() % 4 ? False : True);
+        rules.push_back(builder.build());
+    }
+    
+    TernaryMatcher scan(rules, TernaryScan);
+    TernaryMatcher tuples(rules, TernaryTupleSpace);
+    TernaryMatcher automatic(rules);
+    ASSERT_EQ(0, scan.tuplesCount());
+    ASSERT_LE(tuples.tuplesCount(), 41);
+    ASSERT_EQ(tuples.tuplesCount(), automatic.tuplesCount());
+    
+    for (size_t i = 0; i < 300; i++) {
+        TritSetBuilder builder(40);
+        for (size_t j = 0; j < 40; j++)
+            builder.append(std::rand() % 4 ? False : True);
+        TritSet key = builder.build();
+        
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < rules.size(); j++) {
+            bool matches = true;
+            for (size_t k = 0; k < rules[j].size(); k++)
+                if (rules[j][k] != Unknown && rules[j][k] != key[k])
+                    matches = false;
+            if (matches)
+                expected.push_back(j);
+        }
+        
+        ASSERT_EQ(expected, scan.matchAll(key));
+        ASSERT_EQ(expected, tuples.matchAll(key));
+        ASSERT_EQ(expected.empty() ? TritSet::npos : expected[0], scan.match(key));
+        ASSERT_EQ(expected.empty() ? TritSet::npos : expected[0], tuples.match(key));
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  matrix_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include "gtest/gtest.h"
+#include "test_sets.h"
+#include "TritMatrix.h"
+
+TEST(Matrix, Transpose) {
+    // Размеры не кратны ни блоку, ни четырем блокам
+    std::vector<TritSet> rows = randomSets(150, 200);
+    TritMatrix matrix(rows);
+    
+    ASSERT_EQ(rows.size(), matrix.rows());
+    
+    for (size_t i = 0; i < matrix.rows(); i++)
+        for (size_t j = 0; j < matrix.columns(); j++)
+            ASSERT_EQ(rows[i][j], matrix.getTrit(i, j));
+    
+    for (size_t j = 0; j < matrix.columns(); j++) {
+        TritSetView column = matrix.column(j);
+        ASSERT_EQ(matrix.rows(), column.size());
+        for (size_t i = 0; i < matrix.rows(); i++)
+            ASSERT_EQ(rows[i][j], column[i]);
+    }
+    
+    for (size_t i = 0; i < matrix.rows(); i++)
+        ASSERT_TRUE(matrix.row(i) == TritSetView(rows[i]));
+    
+    TritMatrix transposed = matrix.transposed();
+    ASSERT_EQ(matrix.columns(), transposed.rows());
+    for (size_t j = 0; j < matrix.columns(); j++)
+        ASSERT_TRUE(transposed.row(j) == matrix.column(j));
+    
+    ASSERT_EQ(Unknown, matrix.getTrit(matrix.rows(), 0));
+}
+
+TEST(Matrix, Modify) {
+    TritMatrix matrix(40, 70);
+    
+    matrix.setTrit(3, 65, True);
+    matrix.setTrit(39, 0, False);
+    ASSERT_EQ(True, matrix.column(65)[3]);
+    ASSERT_EQ(False, matrix.row(39)[0]);
+    ASSERT_EQ(1, matrix.column(65).cardinality(True));
+    
+    TritSet row(100);
+    row[0] = row[69] = row[99] = True;
+    matrix.setRow(17, TritSetView(row));
+    ASSERT_EQ(70, matrix.row(17).size());
+    ASSERT_EQ(2, matrix.row(17).cardinality(True));
+    ASSERT_EQ(True, matrix.column(69)[17]);
+    ASSERT_EQ(True, matrix.getTrit(3, 65));
+    
+    TritSet column(10);
+    column[5] = False;
+    matrix.setColumn(0, TritSetView(column));
+    ASSERT_EQ(False, matrix.getTrit(5, 0));
+    ASSERT_EQ(Unknown, matrix.getTrit(17, 0));
+    ASSERT_EQ(Unknown, matrix.getTrit(39, 0));
+    ASSERT_EQ(True, matrix.getTrit(17, 69));
+    
+    // Строки и столбцы совместимы с операциями над срезами
+    TritSet both = matrix.column(0) | matrix.column(69);
+    ASSERT_EQ(Unknown, both[5]);
+    ASSERT_EQ(True, both[17]);
+    
+    ASSERT_THROW(matrix.setTrit(40, 0, True), std::out_of_range);
+    ASSERT_THROW(matrix.row(40), std::out_of_range);
+    ASSERT_THROW(matrix.column(70), std::out_of_range);
+    
+    std::vector<TritSet> columns = matrix.toColumns();
+    ASSERT_EQ(70, columns.size());
+    ASSERT_EQ(True, columns[65][3]);
+    ASSERT_EQ(True, TritMatrix(matrix.toRows(), 70).getTrit(3, 65));
+}
@@ -0,0 +1,103 @@
+//
+//  nearest_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "TritDistance.h"
+#include "TritNearestIndex.h"
+#include "TritSetBuilder.h"
+
+/**
+ * Случайные наборы тритов: мутации нескольких центров.
+ */
+static std::vector<TritSet> randomSets(size_t count, size_t size) {
+    std::vector<TritSet> centers;
+    for (size_t i = 0; i < 5; i++) {
+        TritSetBuilder builder(size);
+        for (size_t j = 0; j < size; j++)
+            builder.append(Trit(std::rand() % 3));
+        centers.push_back(builder.build());
+    }
+    
+    std::vector<TritSet> sets;
+    for (size_t i = 0; i < count; i++) {
+        TritSet set = centers[std::rand() % centers.size()];
+        for (size_t j = std::rand() % 20; j > 0; j--)
+            set.setTrit(std::rand() % size, Trit(std::rand() % 3));
+        sets.push_back(set);
+    }
+    
+    return sets;
+}
+
+/**
+ * Все соседи полным перебором в порядке возрастания расстояния.
+ */
+static std::vector<TritNeighbor> bruteForce(const std::vector<TritSet>& sets, const TritSet& query) {
+    std::vector<TritNeighbor> result;
+    for (size_t i = 0; i < sets.size(); i++)
+        result.push_back({i, tritDistance(query, sets[i])});
+    
+    std::sort(result.begin(), result.end(), [](const TritNeighbor& left, const TritNeighbor& right) {
+        return left.distance != right.distance ? left.distance < right.distance : left.index < right.index;
+    });
+    return result;
+}
+
+TEST(NearestIndexTest, Empty) {
+    std::vector<TritSet> sets;
+    TritNearestIndex index(sets);
+    
+    ASSERT_EQ(index.size(), 0);
+    ASSERT_TRUE(index.nearest(TritSet(10, True), 3).empty());
+    ASSERT_TRUE(index.radius(TritSet(10, True), 3).empty());
+}
+
+TEST(NearestIndexTest, MatchesBruteForce) {
+    std::srand(1);
+    std::vector<TritSet> sets = randomSets(500, 100);
+    TritNearestIndex index(sets);
+    ASSERT_EQ(index.size(), sets.size());
+    
+    for (size_t iteration = 0; iteration < 20; iteration++) {
+        TritSet query = randomSets(1, 100)[0];
+        std::vector<TritNeighbor> expected = bruteForce(sets, query);
+        
+        for (size_t k : {1, 5, 50}) {
+            std::vector<TritNeighbor> nearest = index.nearest(query, k);
+            ASSERT_EQ(nearest.size(), k);
+            for (size_t i = 0; i < k; i++) {
+                ASSERT_EQ(nearest[i].index, expected[i].index);
+                ASSERT_EQ(nearest[i].distance, expected[i].distance);
+            }
+        }
+        
+        size_t radius = expected[10].distance;
+        std::vector<TritNeighbor> within = index.radius(query, radius);
+        size_t count = 0;
+        while (count < expected.size() && expected[count].distance <= radius)
+            count++;
+        
+        ASSERT_EQ(within.size(), count);
+        for (size_t i = 0; i < count; i++)
+            ASSERT_EQ(within[i].index, expected[i].index);
+    }
+}
+
+TEST(NearestIndexTest, Duplicates) {
+    std::vector<TritSet> sets(10, TritSet(20, False));
+    TritNearestIndex index(sets);
+    
+    std::vector<TritNeighbor> nearest = index.nearest(TritSet(20, False), 20);
+    ASSERT_EQ(nearest.size(), 10);
+    ASSERT_EQ(nearest.back().distance, 0);
+    ASSERT_EQ(index.radius(TritSet(20, True), 19).size(), 0);
+    ASSERT_EQ(index.radius(TritSet(20, True), 20).size(), 10);
+}
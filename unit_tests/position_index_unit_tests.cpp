@@ -0,0 +1,73 @@
+//
+//  position_index_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "test_sets.h"
+#include "TritPositionIndex.h"
+
+/**
+ * Проверяет условие прямым чтением трита.
+ */
+static bool satisfies(const TritSet& set, const TritCondition& condition) {
+    return (set[condition.pos] == condition.trit) != condition.negate;
+}
+
+TEST(PositionIndex, Example) {
+    std::vector<TritSet> sets(3, TritSet(10000));
+    sets[0][12] = sets[0][400] = sets[0][9001] = True;
+    sets[1][12] = sets[1][400] = sets[1][9001] = True;
+    sets[1][77] = False;
+    sets[2][12] = sets[2][400] = True;
+    
+    TritPositionIndex index(sets);
+    ASSERT_EQ(3, index.size());
+    ASSERT_EQ(9002, index.positions());
+    
+    TritPositionIndex::Bitmap result = index.matchAll({
+        {12, True, false}, {400, True, false}, {9001, True, false}, {77, False, true}
+    });
+    ASSERT_EQ(std::vector<size_t>({0}), TritPositionIndex::indices(result));
+    
+    result = index.matchAny({{77, False, false}, {9001, Unknown, false}});
+    ASSERT_EQ(std::vector<size_t>({1, 2}), TritPositionIndex::indices(result));
+    
+    // Позиции за пределами всех наборов - Unknown
+    ASSERT_EQ(3, TritPositionIndex::count(index.match({20000, Unknown, false})));
+    ASSERT_EQ(0, TritPositionIndex::count(index.match({20000, Unknown, true})));
+    ASSERT_EQ(3, TritPositionIndex::count(index.matchAll({})));
+    ASSERT_EQ(0, TritPositionIndex::count(index.matchAny({})));
+}
+
+TEST(PositionIndex, Random) {
+    std::vector<TritSet> sets = randomSets(300, 200);
+    TritPositionIndex index(sets);
+    
+    for (size_t query = 0; query < 100; query++) {
+        std::vector<TritCondition> conditions;
+        for (size_t i = std::rand() % 4; i > 0; i--)
+            conditions.push_back({(size_t) std::rand() % 220, Trit(std::rand() % 3), std::rand() % 2 == 0});
+        
+        std::vector<size_t> all, any;
+        for (size_t i = 0; i < sets.size(); i++) {
+            bool matchAll = true, matchAny = false;
+            for (const TritCondition& condition : conditions) {
+                matchAll = matchAll && satisfies(sets[i], condition);
+                matchAny = matchAny || satisfies(sets[i], condition);
+            }
+            if (matchAll)
+                all.push_back(i);
+            if (matchAny)
+                any.push_back(i);
+        }
+        
+        ASSERT_EQ(all, TritPositionIndex::indices(index.matchAll(conditions)));
+        ASSERT_EQ(any, TritPositionIndex::indices(index.matchAny(conditions)));
+    }
+}
@@ -0,0 +1,64 @@
+//
+//  rank_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include "gtest/gtest.h"
+#include "test_sets.h"
+#include "TritRankSelect.h"
+
+TEST(RankSelectTest, EmptySet) {
+    TritSet set;
+    TritRankSelect index(set);
+    
+    ASSERT_EQ(index.size(), 0);
+    ASSERT_EQ(index.rank(True, 0), 0);
+    ASSERT_EQ(index.rank(Unknown, 100), 0);
+    ASSERT_EQ(index.select(False, 0), TritSet::npos);
+    ASSERT_EQ(index.select(Unknown, 0), TritSet::npos);
+}
+
+TEST(RankSelectTest, RankMatchesScan) {
+    TritSet set = randomSparseSet(200000, 1);
+    TritRankSelect index(set);
+    
+    size_t counts[3] = {0, 0, 0};
+    for (size_t pos = 0; pos <= set.size(); pos++) {
+        if (pos % 97 == 0 || pos == set.size()) {
+            ASSERT_EQ(index.rank(False, pos), counts[False]);
+            ASSERT_EQ(index.rank(Unknown, pos), counts[Unknown]);
+            ASSERT_EQ(index.rank(True, pos), counts[True]);
+        }
+        if (pos < set.size())
+            counts[set[pos]]++;
+    }
+    
+    ASSERT_EQ(index.rank(True, set.size() + 1000), set.cardinality(True));
+}
+
+TEST(RankSelectTest, SelectMatchesScan) {
+    TritSet set = randomSparseSet(150000, 2);
+    TritRankSelect index(set);
+    
+    size_t counts[3] = {0, 0, 0};
+    for (size_t pos = 0; pos < set.size(); pos++) {
+        Trit trit = set[pos];
+        ASSERT_EQ(index.select(trit, counts[trit]), pos);
+        counts[trit]++;
+    }
+    
+    ASSERT_EQ(index.select(False, counts[False]), TritSet::npos);
+    ASSERT_EQ(index.select(Unknown, counts[Unknown]), TritSet::npos);
+    ASSERT_EQ(index.select(True, counts[True]), TritSet::npos);
+}
+
+TEST(RankSelectTest, SpaceOverhead) {
+    TritSet set(1 << 20, True);
+    TritRankSelect index(set);
+    
+    size_t storage = set.words().size() * sizeof(uint);
+    ASSERT_LE(index.indexSize() * 100, storage * 4);
+}
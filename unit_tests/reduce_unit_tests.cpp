@@ -0,0 +1,135 @@
+//
+//  reduce_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "TritReduce.h"
+#include "TritSetBuilder.h"
+
+/**
+ * Случайный набор тритов, в котором значение trit встречается с вероятностью 1/count.
+ */
+static TritSet randomSet(size_t size, Trit trit, int count) {
+    TritSetBuilder builder(size);
+    
+    for (size_t i = 0; i < size; i++) {
+        int value = std::rand() % (count * 2);
+        builder.append(value == 0 ? trit : (value % 2 ? Unknown : ~trit));
+    }
+    
+    return builder.build();
+}
+
+TEST(ReduceTest, Empty) {
+    ASSERT_EQ(reduceAnd(std::vector<const TritSet*>()).size(), 0);
+    ASSERT_EQ(reduceOr(nullptr, 0).size(), 0);
+    
+    TritSet set(50, True);
+    ASSERT_EQ(reduceAnd({&set}), set);
+}
+
+TEST(ReduceTest, MatchesChainedOperators) {
+    std::srand(1);
+    
+    std::vector<TritSet> sets;
+    for (size_t i = 0; i < 40; i++)
+        sets.push_back(randomSet(20000 + std::rand() % 100000, i % 2 ? True : False, 30));
+    
+    std::vector<const TritSet*> pointers;
+    for (const TritSet& set : sets)
+        pointers.push_back(&set);
+    
+    TritSet expectedAnd = sets[0], expectedOr = sets[0];
+    for (size_t i = 1; i < sets.size(); i++) {
+        expectedAnd = expectedAnd & sets[i];
+        expectedOr = expectedOr | sets[i];
+    }
+    
+    TritSet resultAnd = reduceAnd(pointers);
+    TritSet resultOr = reduceOr(pointers);
+    
+    ASSERT_EQ(resultAnd, expectedAnd);
+    ASSERT_EQ(resultAnd.size(), expectedAnd.size());
+    ASSERT_EQ(resultOr, expectedOr);
+    ASSERT_EQ(resultOr.size(), expectedOr.size());
+}
+
+TEST(ReduceTest, Saturation) {
+    TritSet falses(100000, False), trues(100000, True);
+    TritSet shorter(10, Unknown);
+    shorter.setTrit(3, True);
+    
+    std::vector<const TritSet*> sets = {&trues, &falses, &shorter, &trues};
+    
+    ASSERT_EQ(reduceAnd(sets), falses);
+    ASSERT_EQ(reduceOr(sets), trues);
+    
+    std::vector<const TritSet*> unknowns = {&shorter, &shorter};
+    ASSERT_EQ(reduceAnd(unknowns), shorter);
+}
+
+TEST(CountTest, MatchesScan) {
+    std::srand(2);
+    
+    for (size_t setsCount : {1, 3, 8, 13, 40}) {
+        std::vector<TritSet> sets;
+        for (size_t i = 0; i < setsCount; i++)
+            sets.push_back(randomSet(1 + std::rand() % 5000, Trit(std::rand() % 3), 2));
+        
+        std::vector<const TritSet*> pointers;
+        for (const TritSet& set : sets)
+            pointers.push_back(&set);
+        
+        TritCounts counts = countTrits(pointers);
+        ASSERT_EQ(counts.setsCount(), setsCount);
+        
+        size_t size = 0;
+        for (const TritSet& set : sets)
+            size = std::max(size, set.size());
+        ASSERT_EQ(counts.size(), size);
+        
+        for (size_t pos = 0; pos < size + 10; pos++) {
+            size_t expected[3] = {};
+            for (const TritSet& set : sets)
+                expected[set.getTrit(pos)]++;
+            
+            ASSERT_EQ(counts.count(pos, False), expected[False]);
+            ASSERT_EQ(counts.count(pos, Unknown), expected[Unknown]);
+            ASSERT_EQ(counts.count(pos, True), expected[True]);
+        }
+    }
+}
+
+TEST(CountTest, Majority) {
+    std::srand(3);
+    
+    for (size_t setsCount : {1, 2, 7, 9, 16, 33}) {
+        std::vector<TritSet> sets;
+        for (size_t i = 0; i < setsCount; i++)
+            sets.push_back(randomSet(3000, True, 2));
+        
+        std::vector<const TritSet*> pointers;
+        for (const TritSet& set : sets)
+            pointers.push_back(&set);
+        
+        TritCounts counts = countTrits(pointers);
+        TritSet result = majority(pointers);
+        TritSet atLeastTwo = tritThreshold(pointers.data(), pointers.size(), 2);
+        
+        for (size_t pos = 0; pos < 3000; pos++) {
+            size_t falses = counts.count(pos, False), trues = counts.count(pos, True);
+            
+            ASSERT_EQ(result.getTrit(pos), falses * 2 > setsCount ? False
+                      : (trues * 2 > setsCount ? True : Unknown));
+            ASSERT_EQ(atLeastTwo.getTrit(pos), falses >= 2 && trues >= 2 ? Unknown
+                      : (falses >= 2 ? False : (trues >= 2 ? True : Unknown)));
+        }
+    }
+}
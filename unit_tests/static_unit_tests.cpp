@@ -0,0 +1,76 @@
+//
+//  static_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "StaticTritSet.h"
+
+/**
+ * Набор, вычисляемый при компиляции.
+ */
+constexpr StaticTritSet<27> compileTimeSet() {
+    StaticTritSet<27> set;
+    for (size_t i = 0; i < 27; i += 3)
+        set.setTrit(i, False).setTrit(i + 1, True);
+    return set;
+}
+
+static_assert(sizeof(StaticTritSet<81>) == 6 * sizeof(uint), "Inline storage");
+static_assert(compileTimeSet().cardinality(False) == 9, "constexpr cardinality");
+static_assert(compileTimeSet().cardinality(Unknown) == 9, "constexpr cardinality");
+static_assert((~compileTimeSet()).getTrit(1) == False, "constexpr NOT");
+static_assert((compileTimeSet() & StaticTritSet<27>(True)) == compileTimeSet(), "constexpr AND");
+static_assert((compileTimeSet() | StaticTritSet<27>(True)).cardinality(True) == 27, "constexpr OR");
+static_assert(StaticTritSet<5>(True).cardinality(True) == 5, "Tail is masked");
+
+TEST(StaticTritSetTest, Empty) {
+    StaticTritSet<0> empty;
+    ASSERT_EQ(empty.size(), 0);
+    ASSERT_EQ(empty.cardinality(Unknown), 0);
+    ASSERT_EQ(empty.toTritSet().size(), 0);
+    
+    StaticTritSet<40> set;
+    ASSERT_EQ(set.size(), 40);
+    ASSERT_EQ(set.cardinality(Unknown), 40);
+    ASSERT_EQ(set.getTrit(100), Unknown);
+}
+
+TEST(StaticTritSetTest, MatchesTritSet) {
+    StaticTritSet<81> left, right;
+    TritSet dynamicLeft, dynamicRight;
+    std::srand(1);
+    
+    for (size_t i = 0; i < 81; i++) {
+        Trit a = Trit(std::rand() % 3), b = Trit(std::rand() % 3);
+        left.setTrit(i, a);
+        right.setTrit(i, b);
+        dynamicLeft.setTrit(i, a);
+        dynamicRight.setTrit(i, b);
+    }
+    
+    ASSERT_EQ(left.toTritSet(), dynamicLeft);
+    ASSERT_EQ((~left).toTritSet(), ~dynamicLeft);
+    ASSERT_EQ((left & right).toTritSet(), dynamicLeft & dynamicRight);
+    ASSERT_EQ((left | right).toTritSet(), dynamicLeft | dynamicRight);
+    ASSERT_EQ(left.cardinality(True), dynamicLeft.cardinality(True));
+    
+    for (size_t i = 0; i < 81; i++)
+        ASSERT_EQ(left[i], dynamicLeft.getTrit(i));
+}
+
+TEST(StaticTritSetTest, FromTritSet) {
+    TritSet set(100, True);
+    StaticTritSet<20> truncated(set);
+    
+    ASSERT_EQ(truncated, StaticTritSet<20>(True));
+    ASSERT_EQ(truncated.toTritSet().size(), 20);
+    
+    truncated.setTrit(25, False);
+    ASSERT_EQ(truncated.cardinality(False), 0);
+}
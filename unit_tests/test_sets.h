@@ -0,0 +1,63 @@
+//
+//  test_sets.h
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#ifndef test_sets_h
+#define test_sets_h
+
+#include <cstdlib>
+#include <vector>
+
+#include "TritSet.h"
+
+/**
+ * Случайный набор тритов данного размера из текущей
+ * последовательности std::rand. Значения равновероятны.
+ */
+inline TritSet randomSet(size_t count) {
+    TritSet set(count);
+    for (size_t i = 0; i < count; i++)
+        set[i] = Trit(std::rand() % 3);
+    return set;
+}
+
+/**
+ * Случайный набор тритов, воспроизводимый по seed.
+ */
+inline TritSet randomSet(size_t count, unsigned seed) {
+    std::srand(seed);
+    return randomSet(count);
+}
+
+/**
+ * Случайный набор тритов с перекосом в сторону Unknown:
+ * False - 20%, True - 10%, Unknown - 70%.
+ */
+inline TritSet randomSparseSet(size_t count, unsigned seed) {
+    TritSet set(count);
+    std::srand(seed);
+    
+    for (size_t i = 0; i < count; i++) {
+        int value = std::rand() % 10;
+        set[i] = value < 2 ? False : (value < 3 ? True : Unknown);
+    }
+    
+    return set;
+}
+
+/**
+ * Наборы тритов случайной длины от 0 до size из текущей
+ * последовательности std::rand.
+ */
+inline std::vector<TritSet> randomSets(size_t count, size_t size) {
+    std::vector<TritSet> sets;
+    for (size_t i = 0; i < count; i++)
+        sets.push_back(randomSet(std::rand() % (size + 1)));
+    return sets;
+}
+
+#endif /* test_sets_h */
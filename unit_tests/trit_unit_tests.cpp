@@ -6,11 +6,16 @@
 //  Copyright © 2017 Кирилл. All rights reserved.
 //
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <sstream>
 #include <string>
 
 #include "gtest/gtest.h"
+#include "test_sets.h"
 #include "TritSet.h"
+#include "TritFormat.h"
 
 /**
  * Преобразует строчную запись тритового числа в набор тритов.
@@ -264,7 +269,7 @@ TEST(OperatorsTritSetTest, OperatorNOTAll) {
 TEST(OperatorsTritSetTest, OperatorORContinually) {
     TritSet setEmpty;
     TritSet setTrue(10, True), setFalse(10, False), setUnknown(10, Unknown);
-
+    
     ASSERT_EQ(setEmpty.size(), 0);
     ASSERT_GE(setEmpty.capacity(), 0);
     
@@ -549,3 +554,492 @@ TEST(OperatorsTritSetTest, OperatorSet) {
     ASSERT_GE(set.capacity(), 10);
     ASSERT_EQ(set.size(), 10);
 }
+
+/** Тритовые операции, вычисляемые при компиляции. */
+
+static_assert(~False == True && ~Unknown == Unknown && ~True == False, "NOT");
+static_assert((Unknown & True) == Unknown && (Unknown & False) == False, "AND");
+static_assert((Unknown | True) == True && (Unknown | False) == Unknown, "OR");
+static_assert(tritImplies(Unknown, Unknown) == Unknown, "Kleene implication");
+static_assert(tritLukasiewiczImplies(Unknown, Unknown) == True, "Lukasiewicz implication");
+
+TEST(OperatorsTritTest, TruthTables) {
+    const Trit trits[] = {False, Unknown, True};
+    
+    // Таблицы истинности, строка - левый операнд, столбец - правый
+    const Trit andTable[3][3] = {{False, False, False}, {False, Unknown, Unknown}, {False, Unknown, True}};
+    const Trit orTable[3][3] = {{False, Unknown, True}, {Unknown, Unknown, True}, {True, True, True}};
+    const Trit impliesTable[3][3] = {{True, True, True}, {Unknown, Unknown, True}, {False, Unknown, True}};
+    const Trit equivalentTable[3][3] = {{True, Unknown, False}, {Unknown, Unknown, Unknown}, {False, Unknown, True}};
+    const Trit lukasiewiczImpliesTable[3][3] = {{True, True, True}, {Unknown, True, True}, {False, Unknown, True}};
+    const Trit lukasiewiczEquivalentTable[3][3] = {{True, Unknown, False}, {Unknown, True, Unknown}, {False, Unknown, True}};
+    const Trit lukasiewiczAndTable[3][3] = {{False, False, False}, {False, False, Unknown}, {False, Unknown, True}};
+    const Trit lukasiewiczOrTable[3][3] = {{False, Unknown, True}, {Unknown, True, True}, {True, True, True}};
+    
+    for (Trit left : trits) {
+        for (Trit right : trits) {
+            ASSERT_EQ(left & right, andTable[left][right]);
+            ASSERT_EQ(left | right, orTable[left][right]);
+            ASSERT_EQ(tritImplies(left, right), impliesTable[left][right]);
+            ASSERT_EQ(tritEquivalent(left, right), equivalentTable[left][right]);
+            ASSERT_EQ(tritLukasiewiczImplies(left, right), lukasiewiczImpliesTable[left][right]);
+            ASSERT_EQ(tritLukasiewiczEquivalent(left, right), lukasiewiczEquivalentTable[left][right]);
+            ASSERT_EQ(tritLukasiewiczAnd(left, right), lukasiewiczAndTable[left][right]);
+            ASSERT_EQ(tritLukasiewiczOr(left, right), lukasiewiczOrTable[left][right]);
+        }
+    }
+}
+
+/** Бинарная сериализация. */
+
+TEST(SerializationTritSetTest, StreamRoundTrip) {
+    TritSet* set = tritSetFromString("FUTTFUUFTTTFUFUTFFTUUUUUTFTFTFTFTTTF");
+    std::stringstream stream;
+    
+    set->serialize(stream);
+    ASSERT_EQ(stream.str().size(), set->serializedSize());
+    
+    TritSet result = TritSet::deserialize(stream);
+    ASSERT_EQ(result, (*set));
+    ASSERT_EQ(result.size(), set->size());
+    
+    delete set;
+}
+
+TEST(SerializationTritSetTest, EmptyRoundTrip) {
+    TritSet set(100);
+    std::stringstream stream;
+    
+    set.serialize(stream);
+    TritSet result = TritSet::deserialize(stream);
+    
+    ASSERT_EQ(result.size(), 0);
+    ASSERT_EQ(result, set);
+}
+
+TEST(SerializationTritSetTest, BufferChunks) {
+    TritSet set(1000, True);
+    set.setTrit(500, False).setTrit(999, Unknown);
+    
+    std::vector<uint8_t> image(set.serializedSize());
+    ASSERT_EQ(set.serialize(image.data(), image.size()), image.size());
+    ASSERT_EQ(TritSet::deserialize(image.data(), image.size()), set);
+    
+    // Передача через буфер размером, не кратным заголовку и слову
+    uint8_t buffer[7];
+    TritSetDecoder decoder;
+    size_t offset = 0, written;
+    while ((written = set.serialize(buffer, sizeof(buffer), offset))) {
+        ASSERT_TRUE(std::equal(buffer, buffer + written, image.begin() + offset));
+        ASSERT_EQ(decoder.feed(buffer, written), written);
+        offset += written;
+    }
+    
+    ASSERT_EQ(offset, image.size());
+    ASSERT_TRUE(decoder.complete());
+    ASSERT_EQ(decoder.finish(), set);
+}
+
+TEST(SerializationTritSetTest, HeaderLittleEndian) {
+    TritSet set(1000, True);
+    std::vector<uint8_t> image(set.serializedSize());
+    set.serialize(image.data(), image.size());
+    
+    // Поля заголовка записаны little-endian независимо от платформы
+    ASSERT_EQ(TRIT_FILE_VERSION, image[4]);
+    ASSERT_EQ(0, image[5]);
+    ASSERT_EQ(TritLittleEndian, image[7]);
+    ASSERT_EQ(1000 % 256, image[8]);
+    ASSERT_EQ(1000 / 256, image[9]);
+    ASSERT_EQ(63, image[16]);
+    
+    TritFileHeader header = tritFileHeaderDecode(image.data());
+    ASSERT_EQ(1000, header.tritsCount);
+    ASSERT_EQ(63, header.wordsCount);
+    
+    uint8_t encoded[sizeof(TritFileHeader)];
+    tritFileHeaderEncode(header, encoded);
+    ASSERT_TRUE(std::equal(encoded, encoded + sizeof(encoded), image.begin()));
+}
+
+TEST(SerializationTritSetTest, CorruptedData) {
+    TritSet set(100, False);
+    std::vector<uint8_t> image(set.serializedSize());
+    set.serialize(image.data(), image.size());
+    
+    ASSERT_THROW(TritSet::deserialize(image.data(), image.size() - 1), std::runtime_error);
+    
+    image.back() ^= 0xFF;
+    ASSERT_THROW(TritSet::deserialize(image.data(), image.size()), std::runtime_error);
+    
+    image[0] = 'X';
+    ASSERT_THROW(TritSet::deserialize(image.data(), image.size()), std::runtime_error);
+    
+    std::stringstream stream("TRIT");
+    ASSERT_THROW(TritSet::deserialize(stream), std::runtime_error);
+}
+
+/** Текстовое представление. */
+
+TEST(TextTritSetTest, OutputOperator) {
+    TritSet* set = tritSetFromString("FUTTFUUFTTTFUFUTFFTUUUUUTFTFTFTFTTTF");
+    std::ostringstream stream;
+    
+    stream << (*set);
+    ASSERT_EQ(stream.str(), "FUTTFUUFTTTFUFUTFFTUUUUUTFTFTFTFTTTF");
+    
+    stream.str("");
+    (*set) << stream;
+    ASSERT_EQ(stream.str(), "FUTTFUUFTTTFUFUTFFTUUUUUTFTFTFTFTTTF");
+    
+    stream.str("");
+    stream << TritSet(10);
+    ASSERT_EQ(stream.str(), "");
+    
+    delete set;
+}
+
+TEST(TextTritSetTest, InputOperator) {
+    std::istringstream stream("  FUTtfuUFTTTFUFUTFFTUUUUUTFTFTF ftu FUX");
+    TritSet set;
+    
+    ASSERT_TRUE(stream >> set);
+    TritSet* expected = tritSetFromString("FUTTFUUFTTTFUFUTFFTUUUUUTFTFTF");
+    ASSERT_EQ(set, (*expected));
+    delete expected;
+    
+    ASSERT_TRUE(stream >> set);
+    expected = tritSetFromString("FTU");
+    ASSERT_EQ(set, (*expected));
+    
+    ASSERT_FALSE(stream >> set);
+    ASSERT_EQ(set, (*expected));
+    delete expected;
+}
+
+TEST(TextTritSetTest, CharsRoundTrip) {
+    TritSet set(1000, True);
+    for (size_t i = 0; i < 1000; i += 3)
+        set[i] = i % 2 ? False : Unknown;
+    
+    std::string text(1000, ' ');
+    ASSERT_EQ(tritSetToChars(&text[0], &text[0] + 999, set), nullptr);
+    ASSERT_EQ(tritSetToChars(&text[0], &text[0] + 1000, set), &text[0] + 1000);
+    
+    for (size_t i = 0; i < 1000; i++)
+        ASSERT_EQ(text[i], set[i] == True ? 'T' : (set[i] == False ? 'F' : 'U'));
+    
+    TritSet result;
+    ASSERT_EQ(tritSetFromChars(text.data(), text.data() + text.size(), result), text.data() + text.size());
+    ASSERT_EQ(result, set);
+}
+
+TEST(TextTritSetTest, CharsInvalid) {
+    std::string text = "TTTTTTTTTTTTTTTTTTTTFTX" + std::string(40, 'T');
+    TritSet set;
+    
+    ASSERT_EQ(tritSetFromChars(text.data(), text.data() + text.size(), set), text.data() + 22);
+    ASSERT_EQ(set.size(), 22);
+    ASSERT_EQ(set.cardinality(True), 21);
+    ASSERT_EQ(set[20], False);
+    
+    ASSERT_EQ(tritSetFromChars(text.data() + 22, text.data() + text.size(), set), text.data() + 22);
+    ASSERT_EQ(set.size(), 0);
+}
+
+/** Поиск тритов. */
+
+TEST(MethodsTritSetTest, FindForward) {
+    TritSet* set = tritSetFromString("UUFUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUTUFFT");
+    
+    ASSERT_EQ(set->findFirst(False), 2);
+    ASSERT_EQ(set->findNext(False, 2), 38);
+    ASSERT_EQ(set->findNext(False, 38), 39);
+    ASSERT_EQ(set->findNext(False, 39), TritSet::npos);
+    
+    ASSERT_EQ(set->findFirst(True), 36);
+    ASSERT_EQ(set->findNext(True, 36), 40);
+    ASSERT_EQ(set->findNext(True, 40), TritSet::npos);
+    
+    ASSERT_EQ(set->findFirst(Unknown), 0);
+    ASSERT_EQ(set->findNext(Unknown, 2), 3);
+    ASSERT_EQ(set->findNext(Unknown, 36), 37);
+    ASSERT_EQ(set->findNext(Unknown, 37), TritSet::npos);
+    ASSERT_EQ(set->findNext(Unknown, TritSet::npos), TritSet::npos);
+    
+    delete set;
+}
+
+TEST(MethodsTritSetTest, FindBackward) {
+    TritSet* set = tritSetFromString("TUFUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUTUFFU");
+    
+    ASSERT_EQ(set->findLast(False), 39);
+    ASSERT_EQ(set->findPrev(False, 39), 38);
+    ASSERT_EQ(set->findPrev(False, 38), 2);
+    ASSERT_EQ(set->findPrev(False, 2), TritSet::npos);
+    
+    ASSERT_EQ(set->findLast(True), 36);
+    ASSERT_EQ(set->findPrev(True, 36), 0);
+    ASSERT_EQ(set->findPrev(True, 0), TritSet::npos);
+    
+    ASSERT_EQ(set->findLast(Unknown), 37);
+    ASSERT_EQ(set->findPrev(Unknown, 36), 35);
+    ASSERT_EQ(set->findPrev(Unknown, 1000), 37);
+    
+    delete set;
+}
+
+TEST(MethodsTritSetTest, FindEnumerate) {
+    TritSet set(1000);
+    for (size_t i = 0; i < 1000; i += 7)
+        set[i] = True;
+    
+    size_t count = 0;
+    for (size_t pos = set.findFirst(True); pos != TritSet::npos; pos = set.findNext(True, pos)) {
+        ASSERT_EQ(pos, count * 7);
+        count++;
+    }
+    ASSERT_EQ(count, set.cardinality(True));
+    
+    count = 0;
+    for (size_t pos = set.findLast(True); pos != TritSet::npos; pos = set.findPrev(True, pos))
+        count++;
+    ASSERT_EQ(count, set.cardinality(True));
+    
+    ASSERT_EQ(TritSet().findFirst(Unknown), TritSet::npos);
+    ASSERT_EQ(TritSet().findLast(False), TritSet::npos);
+}
+
+/** Итераторы. */
+
+TEST(IteratorsTritSetTest, ConstIterator) {
+    const TritSet* set = tritSetFromString("FUTTFUUFTTTFUFUTFFTUUUUUTFTFTFTFTTTF");
+    
+    ASSERT_EQ(set->end() - set->begin(), set->size());
+    
+    size_t pos = 0;
+    for (Trit trit : *set)
+        ASSERT_EQ(trit, set->getTrit(pos++));
+    ASSERT_EQ(pos, set->size());
+    
+    TritSet::const_iterator it = set->cbegin();
+    ASSERT_EQ(it[17], set->getTrit(17));
+    ASSERT_EQ(*(it + 33), set->getTrit(33));
+    ASSERT_EQ(*(set->cend() - 1), False);
+    
+    it += 20;
+    ASSERT_EQ(*it--, set->getTrit(20));
+    ASSERT_EQ(*it, set->getTrit(19));
+    
+    ASSERT_EQ(std::count(set->begin(), set->end(), True), set->cardinality(True));
+    ASSERT_EQ(std::find(set->begin(), set->end(), Unknown) - set->begin(), 1);
+    
+    delete set;
+}
+
+TEST(IteratorsTritSetTest, MutableIterator) {
+    TritSet* set = tritSetFromString("FUTTFUUFTT");
+    
+    for (TritSet::iterator it = set->begin(); it != set->end(); ++it)
+        if (*it == Unknown)
+            *it = True;
+    
+    TritSet* expected = tritSetFromString("FTTTFTTFTT");
+    ASSERT_EQ((*set), (*expected));
+    delete expected;
+    
+    std::reverse(set->begin(), set->end());
+    expected = tritSetFromString("TTFTTFTTTF");
+    ASSERT_EQ((*set), (*expected));
+    delete expected;
+    
+    std::sort(set->begin(), set->end());
+    expected = tritSetFromString("FFFTTTTTTT");
+    ASSERT_EQ((*set), (*expected));
+    delete expected;
+    
+    delete set;
+}
+
+TEST(IteratorsTritSetTest, MutableIteratorSize) {
+    TritSet set(40, False);
+    
+    // Запись Unknown в последний трит сдвигает конец набора назад
+    TritSet::iterator last = set.end() - 1;
+    *last = Unknown;
+    ASSERT_EQ(set.size(), 39);
+    
+    std::fill(set.begin() + 20, set.end(), Unknown);
+    ASSERT_EQ(set.size(), 20);
+    ASSERT_EQ(set.cardinality(False), 20);
+    
+    // Запись внутри хранилища за концом набора продвигает конец
+    TritSet::iterator it = set.begin() + 35;
+    *it = True;
+    ASSERT_EQ(set.size(), 36);
+    ASSERT_EQ(set[35], True);
+    ASSERT_EQ(it[-35], False);
+    
+    // Запись за пределами хранилища идет через setTrit
+    TritSet::iterator far = set.begin() + 100;
+    *far = True;
+    ASSERT_EQ(set.size(), 101);
+    ASSERT_EQ(set[100], True);
+    
+    std::fill(set.begin(), set.end(), Unknown);
+    ASSERT_EQ(set.size(), 0);
+}
+
+TEST(IteratorsTritSetTest, Positions) {
+    TritSet set(1000);
+    for (size_t i = 3; i < 1000; i += 10)
+        set[i] = False;
+    
+    size_t count = 0;
+    for (size_t pos : set.positions(False)) {
+        ASSERT_EQ(pos, count * 10 + 3);
+        count++;
+    }
+    ASSERT_EQ(count, 100);
+    
+    ASSERT_EQ(std::distance(set.positions(Unknown).begin(), set.positions(Unknown).end()), set.cardinality(Unknown));
+    ASSERT_TRUE(set.positions(True).begin() == set.positions(True).end());
+}
+
+/** Сдвиги и копирование диапазонов. */
+
+TEST(MethodsTritSetTest, CopyRange) {
+    TritSet source = randomSet(200, 1);
+    
+    for (size_t sourcePos : {0, 1, 16, 23, 190}) {
+        for (size_t pos : {0, 5, 16, 47}) {
+            for (size_t length : {0, 1, 16, 33, 150}) {
+                TritSet set = randomSet(100, 2);
+                TritSet expected = set;
+                for (size_t i = 0; i < length; i++)
+                    expected.setTrit(pos + i, source.getTrit(sourcePos + i));
+                
+                set.copyRange(source, sourcePos, pos, length);
+                ASSERT_EQ(set, expected);
+                ASSERT_EQ(set.size(), expected.size());
+            }
+        }
+    }
+}
+
+TEST(MethodsTritSetTest, CopyRangeOverlapping) {
+    TritSet original = randomSet(150, 3);
+    
+    for (size_t sourcePos : {0, 3, 16, 40}) {
+        for (size_t pos : {0, 2, 16, 35, 41}) {
+            TritSet set = original;
+            TritSet expected = original;
+            for (size_t i = 0; i < 100; i++)
+                expected.setTrit(pos + i, original.getTrit(sourcePos + i));
+            
+            set.copyRange(set, sourcePos, pos, 100);
+            ASSERT_EQ(set, expected);
+        }
+    }
+}
+
+TEST(MethodsTritSetTest, Shifts) {
+    TritSet original = randomSet(70, 4);
+    
+    for (size_t count : {0, 1, 15, 16, 17, 40, 100}) {
+        TritSet set = original;
+        TritSet expected;
+        for (size_t i = 0; i < original.size(); i++)
+            expected.setTrit(i + count, original.getTrit(i));
+        
+        set <<= count;
+        ASSERT_EQ(set, expected);
+        ASSERT_EQ(set.size(), expected.size());
+        
+        set >>= count;
+        ASSERT_EQ(set, original);
+        ASSERT_EQ(set.size(), original.size());
+    }
+    
+    TritSet set = original;
+    set >>= 100;
+    ASSERT_EQ(set.size(), 0);
+}
+
+TEST(MethodsTritSetTest, AppendInsert) {
+    TritSet* left = tritSetFromString("FUTTFUUFTTTFUFUTF");
+    TritSet* right = tritSetFromString("TTUF");
+    
+    TritSet set = *left;
+    set.append(*right);
+    TritSet* expected = tritSetFromString("FUTTFUUFTTTFUFUTFTTUF");
+    ASSERT_EQ(set, (*expected));
+    delete expected;
+    
+    set = *left;
+    set.insert(3, *right);
+    expected = tritSetFromString("FUTTTUFTFUUFTTTFUFUTF");
+    ASSERT_EQ(set, (*expected));
+    delete expected;
+    
+    set.insert(0, set);
+    ASSERT_EQ(set.size(), 42);
+    ASSERT_EQ(TritSet(set).trim(21), TritSet(set) >>= 21);
+    
+    delete left;
+    delete right;
+}
+
+/** Расширенные операции над наборами. */
+
+TEST(OperatorsTritSetTest, ExtendedOperators) {
+    const Trit trits[] = {False, Unknown, True};
+    TritSet left, right;
+    
+    // Все пары значений, повторенные с разными сдвигами внутри слова
+    size_t pos = 0;
+    for (size_t repeat = 0; repeat < 5; repeat++)
+        for (Trit a : trits)
+            for (Trit b : trits) {
+                left.setTrit(pos, a);
+                right.setTrit(pos, b);
+                pos++;
+            }
+    
+    TritSet xorResult = left ^ right;
+    TritSet impliesResult = left.implies(right);
+    TritSet equivalentResult = left.equivalent(right);
+    TritSet consensusResult = left.consensus(right);
+    
+    for (size_t i = 0; i < pos; i++) {
+        Trit a = left.getTrit(i), b = right.getTrit(i);
+        ASSERT_EQ(xorResult.getTrit(i), a ^ b);
+        ASSERT_EQ(impliesResult.getTrit(i), tritImplies(a, b));
+        ASSERT_EQ(equivalentResult.getTrit(i), tritEquivalent(a, b));
+        ASSERT_EQ(consensusResult.getTrit(i), tritConsensus(a, b));
+    }
+    
+    ASSERT_EQ(left ^ right, (left | right) & ~(left & right));
+    ASSERT_EQ(left.implies(right), ~left | right);
+}
+
+TEST(OperatorsTritSetTest, ExtendedOperatorsDifferent) {
+    TritSet* left = tritSetFromString("FTUTF");
+    TritSet* right = tritSetFromString("FFTTUFTUFT");
+    
+    // Недостающие триты короткого набора считаются Unknown
+    TritSet* expected = tritSetFromString("FTUFU");
+    ASSERT_EQ((*left) ^ (*right), (*expected));
+    delete expected;
+    
+    expected = tritSetFromString("TFTTTUTUUT");
+    ASSERT_EQ(left->implies(*right), (*expected));
+    delete expected;
+    
+    expected = tritSetFromString("FUUTU");
+    ASSERT_EQ(left->consensus(*right), (*expected));
+    delete expected;
+    
+    delete left;
+    delete right;
+}
@@ -0,0 +1,128 @@
+//
+//  view_unit_tests.cpp
+//  TritDataset
+//
+//  Created by Кирилл on 18.10.26.
+//  Copyright © 2026 Кирилл. All rights reserved.
+//
+
+#include "gtest/gtest.h"
+#include "test_sets.h"
+#include "TritSetView.h"
+
+/**
+ * Копия тритов [start, start + length) по одному триту.
+ */
+static TritSet sliceSet(const TritSet& set, size_t start, size_t length) {
+    TritSet result(length);
+    for (size_t i = 0; i < length; i++)
+        result[i] = set.getTrit(start + i);
+    return result;
+}
+
+TEST(TritSetViewTest, EmptyView) {
+    TritSetView view;
+    
+    ASSERT_EQ(view.size(), 0);
+    ASSERT_EQ(view.getTrit(0), Unknown);
+    ASSERT_EQ(view.cardinality(Unknown), 0);
+    ASSERT_EQ(view.toTritSet().size(), 0);
+    ASSERT_TRUE(view == TritSetView(TritSet()));
+}
+
+TEST(TritSetViewTest, UnalignedSlices) {
+    TritSet set = randomSet(300, 1);
+    
+    for (size_t start = 0; start < 40; start++) {
+        for (size_t length : {0, 1, 15, 16, 17, 100, 250}) {
+            TritSetView view(set, start, length);
+            TritSet expected = sliceSet(set, start, length);
+            
+            ASSERT_EQ(view.size(), length);
+            ASSERT_EQ(view.toTritSet(), expected);
+            ASSERT_TRUE(view == TritSetView(expected));
+            
+            for (size_t i = 0; i < length; i++)
+                ASSERT_EQ(view[i], set.getTrit(start + i));
+            ASSERT_EQ(view[length], Unknown);
+            
+            size_t falses = expected.cardinality(False), trues = expected.cardinality(True);
+            ASSERT_EQ(view.cardinality(False), falses);
+            ASSERT_EQ(view.cardinality(True), trues);
+            ASSERT_EQ(view.cardinality(Unknown), length - falses - trues);
+        }
+    }
+}
+
+TEST(TritSetViewTest, PastEnd) {
+    TritSet set = randomSet(20, 2);
+    TritSetView view(set, 10, 100);
+    
+    ASSERT_EQ(view.size(), 100);
+    ASSERT_EQ(view.getTrit(50), Unknown);
+    ASSERT_EQ(view.cardinality(Unknown), 100 - view.cardinality(False) - view.cardinality(True));
+    ASSERT_EQ(view.toTritSet(), sliceSet(set, 10, 100));
+    
+    ASSERT_EQ(TritSetView(set, 30).size(), 0);
+    ASSERT_EQ(TritSetView(set, 5).size(), set.size() - 5);
+}
+
+TEST(TritSetViewTest, Subview) {
+    TritSet set = randomSet(200, 3);
+    TritSetView view = TritSetView(set, 7, 150).subview(11, 60);
+    
+    ASSERT_EQ(view.toTritSet(), sliceSet(set, 18, 60));
+    ASSERT_EQ(TritSetView(set, 7, 150).subview(140).size(), 10);
+    ASSERT_EQ(TritSetView(set, 7, 150).subview(200).size(), 0);
+}
+
+TEST(TritSetViewTest, Operations) {
+    TritSet left = randomSet(500, 4);
+    TritSet right = randomSet(500, 5);
+    
+    TritSetView leftView(left, 33, 200);
+    TritSetView rightView(right, 70, 300);
+    TritSet leftSlice = sliceSet(left, 33, 200);
+    TritSet rightSlice = sliceSet(right, 70, 300);
+    
+    ASSERT_EQ(~leftView, ~leftSlice);
+    ASSERT_EQ(leftView & rightView, leftSlice & rightSlice);
+    ASSERT_EQ(leftView | rightView, leftSlice | rightSlice);
+    ASSERT_EQ(leftView & right, leftSlice & right);
+}
+
+TEST(TritSetViewTest, OperationsIntoWords) {
+    TritSet left = randomSet(500, 6);
+    TritSet right = randomSet(500, 7);
+    
+    TritSetView leftView(left, 33, 200);
+    TritSetView rightView(right, 70, 300);
+    std::vector<uint> words(rightView.wordsCount());
+    
+    ASSERT_EQ(tritViewAnd(leftView, rightView, words.data()), words.size());
+    ASSERT_EQ(TritSet::fromWords(words.data(), words.size()), leftView & rightView);
+    
+    ASSERT_EQ(tritViewOr(leftView, rightView, words.data()), words.size());
+    ASSERT_EQ(TritSet::fromWords(words.data(), words.size()), leftView | rightView);
+    
+    ASSERT_EQ(tritViewNot(leftView, words.data()), leftView.wordsCount());
+    ASSERT_EQ(TritSet::fromWords(words.data(), leftView.wordsCount()), ~leftView);
+    
+    // Результат на месте хранилища среза с невыровненным началом
+    TritSet expected = ~TritSetView(left, 5);
+    std::vector<uint> storage = left.words();
+    size_t count = tritViewNot(TritSetView(storage.data(), left.size(), 5), storage.data());
+    ASSERT_EQ(TritSet::fromWords(storage.data(), count), expected);
+}
+
+TEST(TritSetViewTest, Comparison) {
+    TritSet set = randomSet(100, 6);
+    TritSet copy(200);
+    
+    for (size_t i = 0; i < 100; i++)
+        copy[i + 50] = set.getTrit(i);
+    
+    ASSERT_TRUE(TritSetView(copy, 50) == set);
+    ASSERT_TRUE(TritSetView(copy, 51) != set);
+    ASSERT_TRUE(TritSetView(copy, 50, 100) == TritSetView(set, 0, 150));
+}